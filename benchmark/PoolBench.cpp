@@ -1,16 +1,32 @@
 #include <cassert>
+#include <cstdlib>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/benchmark/catch_benchmark.hpp>
+#include <array>
+#include <cstdint>
+#include <list>
 #include <vector>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
 
+#include "../src/BitmapIndexer.h"
+#include "../src/BufferPool.h"
 #include "../src/ConcurrentIndexer.h"
+#include "../src/MagazineIndexer.h"
+#include "../src/Occupancy.h"
+#include "../src/PaddedStorage.h"
 #include "../src/Pool.h"
+#include "../src/PoolAllocator.h"
 #include "../src/PoolItem.h"
+#include "../src/PoolStats.h"
+#include "../src/ResetPolicies.h"
+#include "../src/RingIndexer.h"
+#include "../src/RseqIndexer.h"
+#include "../src/SoAPool.h"
+#include "../src/StackIndexer.h"
 
 #include "catch2/catch_message.hpp"
 
@@ -26,7 +42,94 @@ struct ResetableInt {
 };
 
 
-template <typename PoolType>
+/**
+ * Take and return one item at a time
+ */
+struct SingleItemOperations {
+    template<typename PoolType>
+    static inline auto Run(PoolType& pool, int iterations) -> void {
+        for(int i = 0 ; i < iterations ; i++) {
+            auto item = pool.Take();
+
+            (void)item; // it shouldn't be need since the destructor has side effects
+
+            // item will be returned to the pool here
+        }
+    }
+};
+
+/**
+ * Take and return items in batches, one batch per iteration
+ */
+template<IndexSizeT BatchSize>
+struct BatchOperations {
+    template<typename PoolType>
+    static inline auto Run(PoolType& pool, int iterations) -> void {
+        vector<typename PoolType::Handle> handles;
+        handles.reserve(BatchSize);
+
+        for(int i = 0 ; i < iterations ; i++) {
+            pool.TakeBatch(BatchSize, handles);
+            pool.ReturnBatch(handles);
+        }
+    }
+};
+
+/**
+ * Take a number of items one by one and then release them, the single item equivalent of BatchOperations
+ */
+template<IndexSizeT BatchSize>
+struct SingleItemBatchOperations {
+    template<typename PoolType>
+    static inline auto Run(PoolType& pool, int iterations) -> void {
+        vector<typename PoolType::Handle> handles;
+        handles.reserve(BatchSize);
+
+        for(int i = 0 ; i < iterations ; i++) {
+            for(IndexSizeT item = 0 ; item < BatchSize ; item++) {
+                auto handle = pool.TakeHandle();
+                if(handle.Empty()) {
+                    break;
+                }
+                handles.push_back(std::move(handle));
+            }
+            handles.clear();
+        }
+    }
+};
+
+/**
+ * Counter small enough for several of them to share a cache line
+ */
+struct ResetableCounter {
+    volatile int value{0};
+
+    auto Reset() ->void {
+        this->value = 0;
+    }
+};
+
+/**
+ * Take one item and write to it repeatedly, while other threads write to their own items
+ */
+template<int WritesPerIteration>
+struct ItemWriteOperations {
+    template<typename PoolType>
+    static inline auto Run(PoolType& pool, int iterations) -> void {
+        auto handle = pool.TakeHandle();
+        if(handle.Empty()) {
+            return;
+        }
+
+        for(int i = 0 ; i < iterations ; i++) {
+            for(int write = 0 ; write < WritesPerIteration ; write++) {
+                handle.Get()->value = handle.Get()->value + 1;
+            }
+        }
+    }
+};
+
+template <typename PoolType, typename Operations = SingleItemOperations>
 class PoolBenchFixture {
   public:
     static const int PoolOperationsIterations = 1000;
@@ -53,7 +156,7 @@ class PoolBenchFixture {
                 return;
             }
 
-            PoolBenchFixture<PoolType>::RunPoolOperationsBenchmark(this->pool,PoolOperationsIterations);
+            PoolBenchFixture<PoolType, Operations>::RunPoolOperationsBenchmark(this->pool,PoolOperationsIterations);
 
             this->tasksCompleted++;
             threadRunCycle++;
@@ -68,13 +171,7 @@ class PoolBenchFixture {
     auto operator=(PoolBenchFixture &&) -> PoolBenchFixture & = delete;
 
     static inline auto RunPoolOperationsBenchmark(PoolType& pool, int iterations) -> void {
-        for(int i = 0 ; i < iterations ; i++) {
-            auto item = pool.Take();
-
-            (void)item; // it shouldn't be need since the destructor has side effects
-
-            // item will be returned to the pool here
-        }
+        Operations::Run(pool, iterations);
     }
 
     PoolBenchFixture(int numThreads, PoolType& dataPool):pool(dataPool) {
@@ -237,6 +334,10 @@ auto execRuntimeConcurrentPoolBench(size_t poolSize, Catch::Benchmark::Chronomet
     execRuntimeBenchmark<RuntimePool<ResetableInt, ConcurrentIndexer>>(poolSize, meter, threadCount);
 }
 
+auto execRuntimeMagazinePoolBench(size_t poolSize, Catch::Benchmark::Chronometer& meter, int threadCount) -> void {
+    execRuntimeBenchmark<RuntimePool<ResetableInt, MagazineIndexer<ConcurrentIndexer>>>(poolSize, meter, threadCount);
+}
+
 TEST_CASE("runtime pool, different indexers, multi-threaded", "[bench][runtime]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
     const int poolSize1k = 1024;
 
@@ -274,4 +375,549 @@ TEST_CASE("runtime pool, different indexers, multi-threaded", "[bench][runtime]"
         execRuntimeConcurrentPoolBench(poolSize1k, meter, threadCount);
     };
 
+    BENCHMARK_ADVANCED("size 1K, magazine indexer, single thread")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeMagazinePoolBench(poolSize1k, meter, 1);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, magazine indexer, hardware concurrency threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeMagazinePoolBench(poolSize1k, meter, static_cast<int>(thread::hardware_concurrency()));
+    };
+
+    BENCHMARK_ADVANCED("size 1K, magazine indexer, 64 threads")(Catch::Benchmark::Chronometer meter) {
+        const int threadCount = 64;
+        execRuntimeMagazinePoolBench(poolSize1k, meter, threadCount);
+    };
+
+}
+
+
+TEST_CASE("pool item and pool handle, main thread", "[bench][handle]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    const int poolSize1k = 1024;
+
+    BENCHMARK_ADVANCED("size 1K, concurrent indexer, pool item")(Catch::Benchmark::Chronometer meter) {
+        RuntimePool<ResetableInt, ConcurrentIndexer> pool(poolSize1k);
+        meter.measure([&pool] {
+            for(int i = 0 ; i < PoolBenchFixture<decltype(pool)>::PoolOperationsIterations ; i++) {
+                auto item = pool.Take();
+                (void)item;
+            }
+        });
+    };
+
+    BENCHMARK_ADVANCED("size 1K, concurrent indexer, pool handle")(Catch::Benchmark::Chronometer meter) {
+        RuntimePool<ResetableInt, ConcurrentIndexer> pool(poolSize1k);
+        meter.measure([&pool] {
+            for(int i = 0 ; i < PoolBenchFixture<decltype(pool)>::PoolOperationsIterations ; i++) {
+                auto handle = pool.TakeHandle();
+                (void)handle;
+            }
+        });
+    };
+}
+
+
+template<typename PoolType, typename Operations>
+auto execBatchBenchmark(size_t poolSize, Catch::Benchmark::Chronometer& meter, int threadCount) -> void {
+    PoolType pool(poolSize);
+    PoolBenchFixture<PoolType, Operations> fixture(threadCount, pool);
+    meter.measure([&fixture] { fixture.runBenchmark(); });
+}
+
+TEST_CASE("runtime pool, batch and single item operations", "[bench][runtime][batch]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    const int poolSize4k = 4096;
+    const int threadCount = 12;
+    constexpr const IndexSizeT batchSize = 64;
+
+    using MutexPool = RuntimePool<ResetableInt, MutexIndexer>;
+    using ConcurrentPool = RuntimePool<ResetableInt, ConcurrentIndexer>;
+
+    BENCHMARK_ADVANCED("size 4K, mutex indexer, 64 single items, single thread")(Catch::Benchmark::Chronometer meter) {
+        execBatchBenchmark<MutexPool, SingleItemBatchOperations<batchSize>>(poolSize4k, meter, 1);
+    };
+
+    BENCHMARK_ADVANCED("size 4K, mutex indexer, batch of 64, single thread")(Catch::Benchmark::Chronometer meter) {
+        execBatchBenchmark<MutexPool, BatchOperations<batchSize>>(poolSize4k, meter, 1);
+    };
+
+    BENCHMARK_ADVANCED("size 4K, concurrent indexer, 64 single items, single thread")(Catch::Benchmark::Chronometer meter) {
+        execBatchBenchmark<ConcurrentPool, SingleItemBatchOperations<batchSize>>(poolSize4k, meter, 1);
+    };
+
+    BENCHMARK_ADVANCED("size 4K, concurrent indexer, batch of 64, single thread")(Catch::Benchmark::Chronometer meter) {
+        execBatchBenchmark<ConcurrentPool, BatchOperations<batchSize>>(poolSize4k, meter, 1);
+    };
+
+    BENCHMARK_ADVANCED("size 4K, mutex indexer, 64 single items, 12 threads")(Catch::Benchmark::Chronometer meter) {
+        execBatchBenchmark<MutexPool, SingleItemBatchOperations<batchSize>>(poolSize4k, meter, threadCount);
+    };
+
+    BENCHMARK_ADVANCED("size 4K, mutex indexer, batch of 64, 12 threads")(Catch::Benchmark::Chronometer meter) {
+        execBatchBenchmark<MutexPool, BatchOperations<batchSize>>(poolSize4k, meter, threadCount);
+    };
+
+    BENCHMARK_ADVANCED("size 4K, concurrent indexer, 64 single items, 12 threads")(Catch::Benchmark::Chronometer meter) {
+        execBatchBenchmark<ConcurrentPool, SingleItemBatchOperations<batchSize>>(poolSize4k, meter, threadCount);
+    };
+
+    BENCHMARK_ADVANCED("size 4K, concurrent indexer, batch of 64, 12 threads")(Catch::Benchmark::Chronometer meter) {
+        execBatchBenchmark<ConcurrentPool, BatchOperations<batchSize>>(poolSize4k, meter, threadCount);
+    };
+}
+
+TEST_CASE("runtime and padded pool, threads writing to their own item", "[bench][runtime][padded]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    // one item per thread, so neighbouring threads get neighbouring items
+    const int threadCount = 4;
+    constexpr const int writesPerIteration = 100;
+
+    using WriteOperations = ItemWriteOperations<writesPerIteration>;
+
+    BENCHMARK_ADVANCED("4 items, runtime pool, 4 threads")(Catch::Benchmark::Chronometer meter) {
+        execBatchBenchmark<RuntimePool<ResetableCounter>, WriteOperations>(threadCount, meter, threadCount);
+    };
+
+    BENCHMARK_ADVANCED("4 items, padded pool, 4 threads")(Catch::Benchmark::Chronometer meter) {
+        execBatchBenchmark<PaddedPool<ResetableCounter>, WriteOperations>(threadCount, meter, threadCount);
+    };
+}
+
+TEST_CASE("runtime pool, with and without statistics", "[bench][runtime][stats]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    const int poolSize1k = 1024;
+    const int threadCount = 12;
+
+    using MutexStatsPool = Pool<ResetableInt, vector<ResetableInt>, BasicMutexIndexer<ShardedStats>, 0, ShardedStats>;
+    using ConcurrentStatsPool = Pool<ResetableInt, vector<ResetableInt>, BasicConcurrentIndexer<ShardedStats>, 0, ShardedStats>;
+
+    BENCHMARK_ADVANCED("size 1K, mutex indexer, no stats, 12 threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeMutexPoolBench(poolSize1k, meter, threadCount);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, mutex indexer, sharded stats, 12 threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<MutexStatsPool>(poolSize1k, meter, threadCount);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, concurrent indexer, no stats, 12 threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeConcurrentPoolBench(poolSize1k, meter, threadCount);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, concurrent indexer, sharded stats, 12 threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<ConcurrentStatsPool>(poolSize1k, meter, threadCount);
+    };
+}
+
+struct ZeroResetableInt {
+    inline auto operator()(ResetableInt* item) const -> void {
+        item->value = 0;
+    }
+};
+
+TEST_CASE("runtime pool, reset policies", "[bench][runtime][reset]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    const int poolSize1k = 1024;
+
+    BENCHMARK_ADVANCED("size 1K, member reset, single thread")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<BasicPool<ResetableInt, MemberReset, vector<ResetableInt>, ConcurrentIndexer>>(poolSize1k, meter, 1);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, callback reset, single thread")(Catch::Benchmark::Chronometer meter) {
+        using CallbackPool = BasicPool<ResetableInt, CallbackReset<ResetableInt>, vector<ResetableInt>, ConcurrentIndexer>;
+        CallbackPool pool(poolSize1k, [](ResetableInt* item) {
+            item->value = 0;
+        });
+        PoolBenchFixture<CallbackPool> fixture(1, pool);
+        meter.measure([&fixture] { fixture.runBenchmark(); });
+    };
+
+    BENCHMARK_ADVANCED("size 1K, functor reset, single thread")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<BasicPool<ResetableInt, ZeroResetableInt, vector<ResetableInt>, ConcurrentIndexer>>(poolSize1k, meter, 1);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, no reset, single thread")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<BasicPool<ResetableInt, NoReset, vector<ResetableInt>, ConcurrentIndexer>>(poolSize1k, meter, 1);
+    };
+}
+
+struct SweepItem {
+    bool inUse{false};
+    int value{0};
+};
+
+TEST_CASE("runtime pool, sweep items in use", "[bench][runtime][occupancy]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    const IndexSizeT poolSize1M = 1024 * 1024;
+    const IndexSizeT inUseCount = poolSize1M / 100;
+
+    BENCHMARK_ADVANCED("size 1M, 1% in use, linear walk")(Catch::Benchmark::Chronometer meter) {
+        // without occupancy tracking, items in use have to be flagged and every item checked
+        vector<SweepItem> items(poolSize1M);
+        for(IndexSizeT i = 0 ; i < inUseCount ; i++) {
+            items[i * (poolSize1M / inUseCount)].inUse = true;
+        }
+
+        meter.measure([&items] {
+            int visited = 0;
+            for(auto& item: items) {
+                if(item.inUse) {
+                    visited += item.value + 1;
+                }
+            }
+            return visited;
+        });
+    };
+
+    BENCHMARK_ADVANCED("size 1M, 1% in use, occupancy bitmap")(Catch::Benchmark::Chronometer meter) {
+        using SweepPool = BasicPool<SweepItem, NoReset, vector<SweepItem>, MutexIndexer, NoStats, ResetOnReturn, OccupancyBitmap>;
+        SweepPool pool(poolSize1M);
+        vector<SweepPool::Handle> handles;
+        pool.TakeBatch(inUseCount, handles);
+
+        meter.measure([&pool] {
+            int visited = 0;
+            pool.ForEachInUse([&visited](IndexSizeT /* index */, SweepItem* item) {
+                visited += item->value + 1;
+            });
+            return visited;
+        });
+    };
+}
+
+struct SessionObject {
+    std::int64_t deadline{0};
+    std::uint32_t id{0};
+    std::uint32_t state{0};
+    std::array<std::int64_t, 20> coldFields{};
+};
+
+TEST_CASE("runtime pool, scan one field of all items", "[bench][runtime][soa]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    const IndexSizeT poolSize64k = 64 * 1024;
+
+    BENCHMARK_ADVANCED("size 64K, array of structs")(Catch::Benchmark::Chronometer meter) {
+        using SessionPool = BasicPool<SessionObject, NoReset, vector<SessionObject>>;
+        SessionPool pool(poolSize64k);
+        vector<SessionPool::Handle> handles;
+        pool.TakeBatch(poolSize64k, handles);
+
+        meter.measure([&handles] {
+            std::int64_t expired = 0;
+            for(auto& handle: handles) {
+                expired += handle.Get()->deadline < 100 ? 1 : 0;
+            }
+            return expired;
+        });
+    };
+
+    BENCHMARK_ADVANCED("size 64K, struct of arrays")(Catch::Benchmark::Chronometer meter) {
+        using SessionPool = SoAPool<SoAFields<std::int64_t, std::uint32_t, std::uint32_t, std::array<std::int64_t, 20>>>;
+        SessionPool pool(poolSize64k);
+
+        meter.measure([&pool] {
+            std::int64_t expired = 0;
+            const auto* deadlines = pool.FieldData<0>();
+            for(IndexSizeT i = 0 ; i < pool.Size() ; i++) {
+                expired += deadlines[i] < 100 ? 1 : 0;
+            }
+            return expired;
+        });
+    };
+}
+
+constexpr const int listNodeCount = 1024;
+
+TEST_CASE("list nodes, pool allocator and default allocator", "[bench][allocator]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+    BENCHMARK_ADVANCED("1K nodes, std::allocator")(Catch::Benchmark::Chronometer meter) {
+        meter.measure([] {
+            list<int> values;
+            for(int i = 0 ; i < listNodeCount ; i++) {
+                values.push_back(i);
+            }
+            return values.size();
+        });
+    };
+
+    BENCHMARK_ADVANCED("1K nodes, pool allocator, mutex indexer")(Catch::Benchmark::Chronometer meter) {
+        BlockPool<MutexIndexer> blocks(listNodeCount, 32);
+        meter.measure([&blocks] {
+            list<int, PoolAllocator<int>> values{PoolAllocator<int>(blocks)};
+            for(int i = 0 ; i < listNodeCount ; i++) {
+                values.push_back(i);
+            }
+            return values.size();
+        });
+    };
+
+    BENCHMARK_ADVANCED("1K nodes, pool allocator, concurrent indexer")(Catch::Benchmark::Chronometer meter) {
+        BlockPool<ConcurrentIndexer> blocks(listNodeCount, 32);
+        meter.measure([&blocks] {
+            list<int, PoolAllocator<int, ConcurrentIndexer>> values{PoolAllocator<int, ConcurrentIndexer>(blocks)};
+            for(int i = 0 ; i < listNodeCount ; i++) {
+                values.push_back(i);
+            }
+            return values.size();
+        });
+    };
+}
+
+/**
+ * Buffers taken from the system allocator, with the same interface as BufferPool
+ */
+struct MallocBuffers {
+    using Buffer = unique_ptr<unsigned char, void(*)(void*)>;
+
+    static inline auto Take(size_t size) -> Buffer {
+        return Buffer(static_cast<unsigned char*>(malloc(size)), free); // NOLINT(cppcoreguidelines-no-malloc, hicpp-no-malloc)
+    }
+};
+
+/**
+ * Take and return buffers of varying sizes, a few at a time
+ */
+struct MixedBufferOperations {
+    template<typename PoolType>
+    static inline auto Run(PoolType& pool, int iterations) -> void {
+        static constexpr const array<size_t, 8> sizes{{40, 200, 64, 1500, 90, 512, 128, 3000}};
+
+        for(int i = 0 ; i < iterations ; i++) {
+            auto first = pool.Take(sizes[static_cast<size_t>(i) % sizes.size()]);
+            auto second = pool.Take(sizes[static_cast<size_t>(i + 3) % sizes.size()]);
+            (void)first;
+            (void)second;
+        }
+    }
+};
+
+template<typename PoolType>
+auto execBufferBenchmark(PoolType& pool, Catch::Benchmark::Chronometer& meter, int threadCount) -> void {
+    PoolBenchFixture<PoolType, MixedBufferOperations> fixture(threadCount, pool);
+    meter.measure([&fixture] { fixture.runBenchmark(); });
+}
+
+TEST_CASE("variable size buffers, buffer pool and malloc", "[bench][buffer]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    const vector<BufferSizeClass> sizeClasses{{64, 256}, {256, 256}, {1024, 256}, {4096, 256}};
+
+    BENCHMARK_ADVANCED("mixed sizes, malloc, single thread")(Catch::Benchmark::Chronometer meter) {
+        MallocBuffers pool;
+        execBufferBenchmark(pool, meter, 1);
+    };
+
+    BENCHMARK_ADVANCED("mixed sizes, buffer pool, single thread")(Catch::Benchmark::Chronometer meter) {
+        BufferPool<ConcurrentIndexer> pool(sizeClasses);
+        execBufferBenchmark(pool, meter, 1);
+    };
+
+    BENCHMARK_ADVANCED("mixed sizes, malloc, 12 threads")(Catch::Benchmark::Chronometer meter) {
+        MallocBuffers pool;
+        execBufferBenchmark(pool, meter, 12);
+    };
+
+    BENCHMARK_ADVANCED("mixed sizes, buffer pool, 12 threads")(Catch::Benchmark::Chronometer meter) {
+        BufferPool<ConcurrentIndexer> pool(sizeClasses);
+        execBufferBenchmark(pool, meter, 12);
+    };
+}
+
+/**
+ * Item spanning many cache lines, with one value per cache line
+ */
+struct LargeItem {
+    array<array<std::int64_t, 8>, 64> lines{};
+};
+
+/**
+ * Take one item at a time and touch every cache line of it before returning it
+ */
+struct TouchLargeItemOperations {
+    template<typename PoolType>
+    static inline auto Run(PoolType& pool, int iterations) -> void {
+        for(int i = 0 ; i < iterations ; i++) {
+            auto handle = pool.TakeHandle();
+            if(handle.Empty()) {
+                continue;
+            }
+
+            for(auto& line: handle.Get()->lines) {
+                line[0]++;
+            }
+        }
+    }
+};
+
+template<typename Indexer>
+auto execLargeItemBenchmark(size_t poolSize, Catch::Benchmark::Chronometer& meter, int threadCount) -> void {
+    using LargeItemPool = BasicPool<LargeItem, NoReset, vector<LargeItem>, Indexer>;
+    LargeItemPool pool(poolSize);
+    PoolBenchFixture<LargeItemPool, TouchLargeItemOperations> fixture(threadCount, pool);
+    meter.measure([&fixture] { fixture.runBenchmark(); });
+}
+
+TEST_CASE("runtime pool, large items, FIFO and LIFO indexers", "[bench][runtime][stack]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    // 16MB of items, larger than the last level cache of most CPUs
+    const size_t poolSize4k = 4096;
+
+    BENCHMARK_ADVANCED("size 4K, 4KB items, concurrent indexer, single thread")(Catch::Benchmark::Chronometer meter) {
+        execLargeItemBenchmark<ConcurrentIndexer>(poolSize4k, meter, 1);
+    };
+
+    BENCHMARK_ADVANCED("size 4K, 4KB items, stack indexer, single thread")(Catch::Benchmark::Chronometer meter) {
+        execLargeItemBenchmark<StackIndexer>(poolSize4k, meter, 1);
+    };
+
+    BENCHMARK_ADVANCED("size 4K, 4KB items, concurrent indexer, 4 threads")(Catch::Benchmark::Chronometer meter) {
+        execLargeItemBenchmark<ConcurrentIndexer>(poolSize4k, meter, 4);
+    };
+
+    BENCHMARK_ADVANCED("size 4K, 4KB items, stack indexer, 4 threads")(Catch::Benchmark::Chronometer meter) {
+        execLargeItemBenchmark<StackIndexer>(poolSize4k, meter, 4);
+    };
+}
+
+TEST_CASE("runtime pool, bitmap indexer", "[bench][runtime][bitmap]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    const size_t poolSize4k = 4096;
+    const size_t poolSize1k = 1024;
+
+    BENCHMARK_ADVANCED("size 4K, 4KB items, bitmap indexer, single thread")(Catch::Benchmark::Chronometer meter) {
+        execLargeItemBenchmark<BitmapIndexer>(poolSize4k, meter, 1);
+    };
+
+    BENCHMARK_ADVANCED("size 4K, 4KB items, bitmap indexer, 4 threads")(Catch::Benchmark::Chronometer meter) {
+        execLargeItemBenchmark<BitmapIndexer>(poolSize4k, meter, 4);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, bitmap indexer, single thread")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, BitmapIndexer>>(poolSize1k, meter, 1);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, concurrent indexer, single thread")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeConcurrentPoolBench(poolSize1k, meter, 1);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, bitmap indexer, 12 threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, BitmapIndexer>>(poolSize1k, meter, 12);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, concurrent indexer, 12 threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeConcurrentPoolBench(poolSize1k, meter, 12);
+    };
+}
+
+TEST_CASE("runtime pool, per CPU indexer", "[bench][runtime][rseq]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    const size_t poolSize1k = 1024;
+
+    BENCHMARK_ADVANCED("size 1K, rseq indexer, single thread")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, RseqIndexer<>>>(poolSize1k, meter, 1);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, magazine indexer, single thread")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeMagazinePoolBench(poolSize1k, meter, 1);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, concurrent indexer, single thread")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeConcurrentPoolBench(poolSize1k, meter, 1);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, rseq indexer, 64 threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, RseqIndexer<>>>(poolSize1k, meter, 64);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, magazine indexer, 64 threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeMagazinePoolBench(poolSize1k, meter, 64);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, concurrent indexer, 64 threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeConcurrentPoolBench(poolSize1k, meter, 64);
+    };
+}
+
+TEST_CASE("runtime pool, mutex indexer lock policies", "[bench][runtime][locks]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    const size_t poolSize1k = 1024;
+
+    BENCHMARK_ADVANCED("size 1K, std::mutex, single thread")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, MutexIndexer>>(poolSize1k, meter, 1);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, TTAS spin lock, single thread")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, SpinLockIndexer>>(poolSize1k, meter, 1);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, ticket lock, single thread")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, TicketLockIndexer>>(poolSize1k, meter, 1);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, adaptive lock, single thread")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, AdaptiveLockIndexer>>(poolSize1k, meter, 1);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, std::mutex, 2 threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, MutexIndexer>>(poolSize1k, meter, 2);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, TTAS spin lock, 2 threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, SpinLockIndexer>>(poolSize1k, meter, 2);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, ticket lock, 2 threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, TicketLockIndexer>>(poolSize1k, meter, 2);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, adaptive lock, 2 threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, AdaptiveLockIndexer>>(poolSize1k, meter, 2);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, std::mutex, 12 threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, MutexIndexer>>(poolSize1k, meter, 12);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, TTAS spin lock, 12 threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, SpinLockIndexer>>(poolSize1k, meter, 12);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, ticket lock, 12 threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, TicketLockIndexer>>(poolSize1k, meter, 12);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, adaptive lock, 12 threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, AdaptiveLockIndexer>>(poolSize1k, meter, 12);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, std::mutex, 64 threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, MutexIndexer>>(poolSize1k, meter, 64);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, TTAS spin lock, 64 threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, SpinLockIndexer>>(poolSize1k, meter, 64);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, ticket lock, 64 threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, TicketLockIndexer>>(poolSize1k, meter, 64);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, adaptive lock, 64 threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, AdaptiveLockIndexer>>(poolSize1k, meter, 64);
+    };
+}
+
+TEST_CASE("runtime pool, ring indexer", "[bench][runtime][ring]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    const size_t poolSize1k = 1024;
+
+    BENCHMARK_ADVANCED("size 1K, concurrent indexer, single thread")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, ConcurrentIndexer>>(poolSize1k, meter, 1);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, ring indexer, single thread")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, RingIndexer>>(poolSize1k, meter, 1);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, concurrent indexer, 12 threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, ConcurrentIndexer>>(poolSize1k, meter, 12);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, ring indexer, 12 threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, RingIndexer>>(poolSize1k, meter, 12);
+    };
+
+    // more threads than cores, threads are often preempted in the middle of an operation
+    BENCHMARK_ADVANCED("size 1K, concurrent indexer, 64 threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, ConcurrentIndexer>>(poolSize1k, meter, 64);
+    };
+
+    BENCHMARK_ADVANCED("size 1K, ring indexer, 64 threads")(Catch::Benchmark::Chronometer meter) {
+        execRuntimeBenchmark<RuntimePool<ResetableInt, RingIndexer>>(poolSize1k, meter, 64);
+    };
 }
@@ -0,0 +1,129 @@
+#ifndef ALIGNED_MEMORY_H
+#define ALIGNED_MEMORY_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace dxpool {
+
+/**
+ * @brief Allocate memory aligned to alignment bytes, released with std::free.
+ *
+ * Before C++17, operator new only guarantees the alignment of std::max_align_t, so objects holding members aligned
+ * to a cache line, such as the ConcurrentIndexer, must be allocated with this function instead.
+ *
+ * @param alignment alignment of the memory, a power of two
+ * @param size number of bytes to allocate
+ * @throws std::bad_alloc if the memory could not be allocated
+ * @return void* aligned memory
+ */
+static inline auto AlignedAllocate(std::size_t alignment, std::size_t size) -> void* {
+    void* memory = nullptr;
+    if(posix_memalign(&memory, alignment < sizeof(void*) ? sizeof(void*) : alignment, size) != 0) {
+        throw std::bad_alloc();
+    }
+
+    return memory;
+}
+
+/**
+ * @brief Deleter of objects created by MakeAligned
+ *
+ */
+class AlignedDelete final {
+  public:
+    template<typename Type>
+    auto operator()(Type* object) const -> void {
+        object->~Type();
+        std::free(object); // NOLINT(cppcoreguidelines-no-malloc, cppcoreguidelines-owning-memory)
+    }
+};
+
+/**
+ * @brief Unique pointer to an object created by MakeAligned
+ *
+ */
+template<typename Type>
+using AlignedPtr = std::unique_ptr<Type, AlignedDelete>;
+
+/**
+ * @brief Create an object in memory aligned to its type's alignment, even when it's over-aligned
+ *
+ * @tparam Type type of the object
+ * @param args arguments forwarded to the constructor
+ * @return AlignedPtr<Type> owner of the new object
+ */
+template<typename Type, typename... Args>
+auto MakeAligned(Args&&... args) -> AlignedPtr<Type> {
+    void* memory = AlignedAllocate(alignof(Type), sizeof(Type));
+
+    try {
+        return AlignedPtr<Type>(new(memory) Type(std::forward<Args>(args)...));
+    } catch(...) {
+        std::free(memory); // NOLINT(cppcoreguidelines-no-malloc, cppcoreguidelines-owning-memory)
+        throw;
+    }
+}
+
+/**
+ * @brief Deleter of arrays created by MakeAlignedArray, destroying each of its count elements
+ *
+ */
+class AlignedArrayDelete final {
+  private:
+    std::size_t count{0};
+
+  public:
+    AlignedArrayDelete() = default;
+
+    explicit AlignedArrayDelete(std::size_t elementCount): count(elementCount) {
+    }
+
+    template<typename Type>
+    auto operator()(Type* elements) const -> void {
+        for(std::size_t i = this->count ; i > 0 ; i--) {
+            elements[i - 1].~Type(); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        std::free(elements); // NOLINT(cppcoreguidelines-no-malloc, cppcoreguidelines-owning-memory)
+    }
+};
+
+/**
+ * @brief Unique pointer to an array created by MakeAlignedArray
+ *
+ */
+template<typename Type>
+using AlignedArray = std::unique_ptr<Type[], AlignedArrayDelete>;
+
+/**
+ * @brief Create an array of value initialized elements in memory aligned to their type's alignment, even when it's over-aligned
+ *
+ * @tparam Type type of the elements
+ * @param count number of elements
+ * @return AlignedArray<Type> owner of the new array
+ */
+template<typename Type>
+auto MakeAlignedArray(std::size_t count) -> AlignedArray<Type> {
+    auto* elements = static_cast<Type*>(AlignedAllocate(alignof(Type), sizeof(Type) * count));
+
+    std::size_t constructed = 0;
+    try {
+        for(; constructed < count ; constructed++) {
+            new(&elements[constructed]) Type(); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+    } catch(...) {
+        const AlignedArrayDelete destroyConstructed(constructed);
+        destroyConstructed(elements);
+        throw;
+    }
+
+    return AlignedArray<Type>(elements, AlignedArrayDelete(count));
+}
+
+} // namespace dxpool
+
+#endif // ALIGNED_MEMORY_H
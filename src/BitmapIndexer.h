@@ -0,0 +1,232 @@
+#ifndef BITMAP_INDEXER_H
+#define BITMAP_INDEXER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "IndexHolder.h"
+#include "PoolStats.h"
+#include "TypePolicies.h"
+
+namespace dxpool {
+
+/**
+ * @brief Lock-free indexer handing out the lowest free index, keeping one bit per index in an array of atomic 64 bit words.
+ *
+ * A set bit is a free index. Taking an index finds the first word with a set bit, picks its lowest bit with a count
+ * trailing zeros instruction and clears it with an atomic and, retrying on the same word if another thread claimed
+ * the bit first. Returning an index sets its bit back with an atomic or.
+ *
+ * Since the lowest free index is always taken first, items in use are packed at the front of the pool, so they share
+ * cache lines and pages, and the unused tail of a large pool is never touched and can be paged out.
+ * The indexer itself uses one bit per index.
+ *
+ * Words with no free index at the front of the bitmap are skipped four at a time, with relaxed loads.
+ * The loads are only a hint, every index is claimed with an atomic operation on its word.
+ *
+ * @tparam StatsPolicy statistics collected by the indexer, NoStats or ShardedStats. With ShardedStats the indexer
+ *         also counts the times a bit was claimed by another thread between finding and claiming it as CASRetries
+ */
+template<typename StatsPolicy = NoStats>
+class BasicBitmapIndexer final {
+  private:
+    static constexpr const unsigned BitsPerWord = 64;
+
+    std::size_t numWords;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> words;
+
+    // only updated with statistics enabled, to observe the number of indices in use
+    std::atomic<IndexSizeT> inUse{0};
+
+    StatsPolicy stats;
+
+    static inline auto LowestBit(std::uint64_t word) -> unsigned {
+        return static_cast<unsigned>(__builtin_ctzll(word));
+    }
+
+    inline auto RecordTaken(IndexSizeT taken) -> void {
+        if(!StatsPolicy::Enabled) {
+            return;
+        }
+
+        this->stats.Add(PoolStat::Taken, taken);
+        this->stats.ObserveInUse(this->inUse.fetch_add(taken, std::memory_order_relaxed) + taken);
+    }
+
+    inline auto RecordReturned(IndexSizeT returned) -> void {
+        if(!StatsPolicy::Enabled) {
+            return;
+        }
+
+        this->inUse.fetch_sub(returned, std::memory_order_relaxed);
+        this->stats.Add(PoolStat::Returned, returned);
+    }
+
+    /**
+     * @brief Returns the position of the first word from wordIndex on that has a free index, or numWords if there's none
+     *
+     */
+    inline auto FindWord(std::size_t wordIndex) const -> std::size_t {
+        constexpr const std::size_t wordsPerScan = 4;
+
+        // one branch for every four words. Loads are atomic, as other threads claim and return bits concurrently
+        while(wordIndex + wordsPerScan <= this->numWords) {
+            const std::uint64_t anyFree = this->words[wordIndex].load(std::memory_order_relaxed) |
+                                          this->words[wordIndex + 1].load(std::memory_order_relaxed) |
+                                          this->words[wordIndex + 2].load(std::memory_order_relaxed) |
+                                          this->words[wordIndex + 3].load(std::memory_order_relaxed);
+            if(anyFree != 0) {
+                break;
+            }
+
+            wordIndex += wordsPerScan;
+        }
+
+        while(wordIndex < this->numWords && this->words[wordIndex].load(std::memory_order_relaxed) == 0) {
+            wordIndex++;
+        }
+
+        return wordIndex;
+    }
+
+  public:
+    /**
+     * @brief Construct a new Bitmap Indexer with all indices from 0 to poolSize - 1 free
+     *
+     * @param poolSize number of possible indices
+     */
+    BasicBitmapIndexer(IndexSizeT poolSize): numWords((poolSize + BitsPerWord - 1) / BitsPerWord), words(new std::atomic<std::uint64_t>[this->numWords]) {
+        for(std::size_t w = 0 ; w < this->numWords ; w++) {
+            // bits past the last index are never set, so they're never taken
+            const std::size_t remaining = poolSize - (w * BitsPerWord);
+            this->words[w].store(remaining >= BitsPerWord ? ~std::uint64_t{0} : (std::uint64_t{1} << remaining) - 1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Get the lowest free index
+     * if there are no more indices, the returning IndexHolder will be empty
+     *
+     * @return IndexHolder next available index
+     */
+    auto Next() -> IndexHolder {
+        for(std::size_t w = this->FindWord(0) ; w < this->numWords ; w = this->FindWord(w + 1)) {
+            std::uint64_t word = this->words[w].load(std::memory_order_relaxed);
+
+            while(word != 0) {
+                const std::uint64_t bit = std::uint64_t{1} << LowestBit(word);
+                word = this->words[w].fetch_and(~bit, std::memory_order_acquire);
+
+                if((word & bit) != 0) {
+                    this->RecordTaken(1);
+                    return {(w * BitsPerWord) + LowestBit(bit)};
+                }
+
+                this->stats.Add(PoolStat::CASRetries, 1);
+            }
+        }
+
+        this->stats.Add(PoolStat::TakeFailures, 1);
+        return {};
+    }
+
+    /**
+     * @brief Return an index to the indexer.
+     * There are no checks for validity of the index so callers must ensure the index is within the range of the pool
+     * and that they have not been previously returned.
+     */
+    auto Return(IndexSizeT index) -> void {
+        this->words[index / BitsPerWord].fetch_or(std::uint64_t{1} << (index % BitsPerWord), std::memory_order_release);
+        this->RecordReturned(1);
+    }
+
+    /**
+     * @brief Get up to count of the lowest free indices, claiming all the indices needed from a word with a single atomic and
+     *
+     * @param count maximum number of indices to retrieve
+     * @param outIndices destination of the retrieved indices. It must have space for at least count indices
+     * @return IndexSizeT number of indices written to outIndices. Zero if there are no more indices
+     */
+    auto Next(IndexSizeT count, IndexSizeT* outIndices) -> IndexSizeT {
+        IndexSizeT taken = 0;
+
+        for(std::size_t w = this->FindWord(0) ; w < this->numWords && taken < count ; w = this->FindWord(w + 1)) {
+            std::uint64_t word = this->words[w].load(std::memory_order_relaxed);
+
+            while(word != 0 && taken < count) {
+                // the lowest free bits of the word, as many as still needed
+                std::uint64_t mask = 0;
+                IndexSizeT wanted = count - taken;
+                for(std::uint64_t free = word ; free != 0 && wanted > 0 ; free &= free - 1, wanted--) {
+                    mask |= free & (~free + 1);
+                }
+
+                const std::uint64_t previous = this->words[w].fetch_and(~mask, std::memory_order_acquire);
+                std::uint64_t claimed = previous & mask;
+                if(claimed != mask) {
+                    this->stats.Add(PoolStat::CASRetries, 1);
+                }
+
+                while(claimed != 0) {
+                    outIndices[taken] = (w * BitsPerWord) + LowestBit(claimed); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    taken++;
+                    claimed &= claimed - 1;
+                }
+
+                word = previous & ~mask;
+            }
+        }
+
+        this->RecordTaken(taken);
+        if(taken < count) {
+            this->stats.Add(PoolStat::TakeFailures, 1);
+        }
+
+        return taken;
+    }
+
+    /**
+     * @brief Return a batch of indices, setting the bits of consecutive indices that share a word with a single atomic or.
+     * The same restrictions of Return(IndexSizeT) apply to every index in the batch.
+     *
+     * @param returnedIndices indices to be returned
+     * @param count number of indices in returnedIndices
+     */
+    auto Return(const IndexSizeT* returnedIndices, IndexSizeT count) -> void {
+        IndexSizeT pos = 0;
+        while(pos < count) {
+            const std::size_t w = returnedIndices[pos] / BitsPerWord; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            std::uint64_t mask = 0;
+            for(; pos < count && returnedIndices[pos] / BitsPerWord == w ; pos++) { // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                mask |= std::uint64_t{1} << (returnedIndices[pos] % BitsPerWord); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+
+            this->words[w].fetch_or(mask, std::memory_order_release);
+        }
+
+        this->RecordReturned(count);
+    }
+
+    /**
+     * @brief Returns the statistics collected by the indexer. Empty when using NoStats
+     *
+     * @return PoolStatsSnapshot counter values
+     */
+    auto Stats() const -> PoolStatsSnapshot {
+        return this->stats.Snapshot();
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(BasicBitmapIndexer);
+    ~BasicBitmapIndexer() = default;
+};
+
+/**
+ * @brief Bitmap indexer without statistics
+ *
+ */
+using BitmapIndexer = BasicBitmapIndexer<NoStats>;
+
+} // namespace dxpool
+#endif
@@ -0,0 +1,225 @@
+#ifndef BUFFER_POOL_H
+#define BUFFER_POOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "AlignedMemory.h"
+#include "ConcurrentIndexer.h"
+#include "PoolAllocator.h"
+#include "TypePolicies.h"
+
+namespace dxpool {
+
+class InvalidBufferPoolArgumentsError: public std::invalid_argument {
+    using std::invalid_argument::invalid_argument;
+};
+
+/**
+ * @brief Size and number of the buffers of one size class of a BufferPool
+ *
+ */
+struct BufferSizeClass {
+    std::size_t bufferSize;
+    std::size_t bufferCount;
+};
+
+/**
+ * @brief A pool of variable length byte buffers, served from a set of size classes.
+ *
+ * Each size class is a slab of fixed size buffers, a BlockPool with its own indexer. A buffer is taken from the smallest
+ * class that fits the requested size, or from the next larger one if that class has run out, so taking and returning
+ * a buffer is an index take and return, with no call to the system allocator.
+ *
+ * Buffers are aligned to alignof(std::max_align_t) and their contents are not cleared when returned.
+ *
+ * A pool cannot be copied or moved, and must outlive all buffers taken from it.
+ *
+ * @tparam IndexerPolicy type of indexer used by every size class, ConcurrentIndexer by default.
+ *         The indexer defines the concurrency behaviour when using the pool in a multi-threaded context
+ */
+template<typename IndexerPolicy = ConcurrentIndexer>
+class BufferPool final {
+  public:
+    /**
+     * @brief A buffer taken from a BufferPool, viewed as a span of bytes.
+     * The buffer is returned to its size class when destroyed. Buffers can be moved but not copied
+     *
+     */
+    class Buffer final {
+      private:
+        BlockPool<IndexerPolicy>* sizeClass{nullptr};
+        unsigned char* data{nullptr};
+        std::size_t size{0};
+
+      public:
+        /**
+         * @brief The default constructor creates an empty buffer
+         *
+         */
+        Buffer() = default;
+
+        /**
+         * @brief Construct a new buffer holding a block taken from a size class
+         *
+         * @param ownerClass size class the block was taken from and where it will be returned to
+         * @param block start of the block
+         * @param requestedSize number of bytes requested
+         */
+        Buffer(BlockPool<IndexerPolicy>* ownerClass, void* block, std::size_t requestedSize) noexcept :
+            sizeClass(ownerClass), data(static_cast<unsigned char*>(block)), size(requestedSize) {
+        }
+
+        /**
+         * @brief Move constructor for a buffer. After moved, the buffer is considered empty
+         *
+         * @param movedBuffer buffer to be moved
+         */
+        Buffer(Buffer&& movedBuffer) noexcept : sizeClass(movedBuffer.sizeClass), data(movedBuffer.data), size(movedBuffer.size) {
+            movedBuffer.sizeClass = nullptr;
+            movedBuffer.data = nullptr;
+            movedBuffer.size = 0;
+        }
+
+        auto operator=(Buffer&&) -> Buffer& = delete;
+        Buffer(const Buffer&) = delete;
+        auto operator=(const Buffer&) -> Buffer& = delete;
+
+        /**
+         * @brief Returns true if there is no buffer held
+         *
+         */
+        auto Empty() const -> bool {
+            return this->sizeClass == nullptr;
+        }
+
+        /**
+         * @brief Returns the first byte of the buffer, nullptr if empty
+         *
+         */
+        auto Data() const -> unsigned char* {
+            return this->data;
+        }
+
+        /**
+         * @brief Returns the number of bytes requested when the buffer was taken
+         *
+         */
+        auto Size() const -> std::size_t {
+            return this->size;
+        }
+
+        /**
+         * @brief Returns the number of bytes that can be used, the buffer size of its size class
+         *
+         */
+        auto Capacity() const -> std::size_t {
+            return this->sizeClass == nullptr ? 0 : this->sizeClass->BlockSize();
+        }
+
+        auto begin() const -> unsigned char* { // NOLINT(readability-identifier-naming)
+            return this->data;
+        }
+
+        auto end() const -> unsigned char* { // NOLINT(readability-identifier-naming)
+            return this->data + this->size; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        /**
+         * @brief Destruction returns the buffer to its size class, if there's one held
+         *
+         */
+        ~Buffer() {
+            if(this->sizeClass != nullptr) {
+                this->sizeClass->ReturnBlock(this->data);
+            }
+        }
+    };
+
+  private:
+    // sorted by buffer size. Block pools hold their indexer, which may be over-aligned
+    std::vector<AlignedPtr<BlockPool<IndexerPolicy>>> sizeClasses;
+
+  public:
+    /**
+     * @brief Construct a new buffer pool
+     *
+     * @param classes size and number of buffers of each size class, in any order
+     * @throws InvalidBufferPoolArgumentsError if there are no size classes or a class has a buffer size or count of zero
+     */
+    explicit BufferPool(std::vector<BufferSizeClass> classes) {
+        if(classes.empty()) {
+            throw InvalidBufferPoolArgumentsError("At least one size class is required");
+        }
+
+        std::sort(classes.begin(), classes.end(), [](const BufferSizeClass& left, const BufferSizeClass& right) {
+            return left.bufferSize < right.bufferSize;
+        });
+
+        for(const auto& sizeClass: classes) {
+            if(sizeClass.bufferSize == 0 || sizeClass.bufferCount == 0) {
+                throw InvalidBufferPoolArgumentsError("Buffer sizes and counts must be greater than zero");
+            }
+
+            auto blockPool = MakeAligned<BlockPool<IndexerPolicy>>(sizeClass.bufferCount, sizeClass.bufferSize);
+            this->sizeClasses.push_back(std::move(blockPool));
+        }
+    }
+
+    /**
+     * @brief Construct a new buffer pool
+     *
+     * @param classes size and number of buffers of each size class, in any order
+     * @throws InvalidBufferPoolArgumentsError if there are no size classes or a class has a buffer size or count of zero
+     */
+    BufferPool(std::initializer_list<BufferSizeClass> classes): BufferPool(std::vector<BufferSizeClass>(classes)) {
+    }
+
+    /**
+     * @brief Take a buffer of at least size bytes from the smallest size class with buffers left
+     *
+     * @param size number of bytes needed
+     * @return Buffer will be empty if size is larger than the largest buffer size, or if all classes that fit are exhausted
+     */
+    auto Take(std::size_t size) -> Buffer {
+        for(auto& sizeClass: this->sizeClasses) {
+            if(sizeClass->BlockSize() < size) {
+                continue;
+            }
+
+            void* block = sizeClass->TakeBlock();
+            if(block != nullptr) {
+                return Buffer(sizeClass.get(), block, size);
+            }
+        }
+
+        return {};
+    }
+
+    /**
+     * @brief Returns the largest buffer size that can be taken
+     *
+     */
+    auto MaxBufferSize() const -> std::size_t {
+        return this->sizeClasses.back()->BlockSize();
+    }
+
+    /**
+     * @brief Returns the number of size classes
+     *
+     */
+    auto SizeClassCount() const -> std::size_t {
+        return this->sizeClasses.size();
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(BufferPool);
+    ~BufferPool() = default;
+};
+
+} // namespace dxpool
+
+#endif // BUFFER_POOL_H
@@ -0,0 +1,52 @@
+#ifndef CACHE_LINE_H
+#define CACHE_LINE_H
+
+#include <unistd.h>
+
+#include <cstddef>
+#include <fstream>
+
+namespace dxpool {
+
+/**
+ * @brief Cache line size assumed when it cannot be determined at runtime
+ *
+ */
+const constexpr std::size_t DefaultCacheLineSize = 64;
+
+/**
+ * @brief Returns the size of the L1 data cache line of the CPU the program runs on, detected once at runtime.
+ *
+ * Unlike AtomicAlignment, which must be a compile time constant, the value is queried from sysconf or,
+ * if unavailable, from sysfs, falling back to DefaultCacheLineSize. The result is always a power of two.
+ *
+ * @return std::size_t cache line size in bytes
+ */
+static inline auto CacheLineSize() -> std::size_t {
+    static const std::size_t cacheLineSize = []() -> std::size_t {
+        auto isPowerOfTwo = [](std::size_t value) -> bool {
+            return value > 0 && (value & (value - 1)) == 0;
+        };
+
+#ifdef _SC_LEVEL1_DCACHE_LINESIZE
+        const long sysconfSize = sysconf(_SC_LEVEL1_DCACHE_LINESIZE); // NOLINT(google-runtime-int)
+        if(sysconfSize > 0 && isPowerOfTwo(static_cast<std::size_t>(sysconfSize))) {
+            return static_cast<std::size_t>(sysconfSize);
+        }
+#endif
+
+        std::ifstream sysfsLineSize("/sys/devices/system/cpu/cpu0/cache/index0/coherency_line_size");
+        std::size_t sysfsSize = 0;
+        if(sysfsLineSize >> sysfsSize && isPowerOfTwo(sysfsSize)) {
+            return sysfsSize;
+        }
+
+        return DefaultCacheLineSize;
+    }();
+
+    return cacheLineSize;
+}
+
+} // namespace dxpool
+
+#endif // CACHE_LINE_H
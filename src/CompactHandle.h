@@ -0,0 +1,182 @@
+#ifndef COMPACT_HANDLE_H
+#define COMPACT_HANDLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+#include "IndexHolder.h"
+#include "TypePolicies.h"
+
+namespace dxpool {
+
+/**
+ * @brief A reference to a pool item packed in a single 64 bit word: the item's index in the lower 32 bits
+ * and the generation of the item's slot in the upper 32 bits.
+ *
+ * Pools using the SlotGenerations policy increment the generation of a slot whenever its item is returned, so a compact handle
+ * kept after the item was recycled no longer resolves (see Pool::Resolve).
+ * Unlike PoolHandle, a compact handle doesn't own the item and can be freely copied and stored, e.g. in timer wheels or hash maps.
+ *
+ * Generations wrap after 2^32 returns of the same slot, after which a stale handle could resolve again.
+ */
+class CompactHandle final {
+  private:
+    static constexpr std::uint64_t EmptyValue = std::numeric_limits<std::uint64_t>::max();
+    static constexpr unsigned GenerationShift = 32;
+
+    std::uint64_t value{EmptyValue};
+
+    explicit constexpr CompactHandle(std::uint64_t packedValue): value(packedValue) {
+    }
+
+  public:
+    /**
+     * @brief The default constructor creates an empty handle, which never resolves
+     *
+     */
+    constexpr CompactHandle() = default;
+
+    /**
+     * @brief Construct a new compact handle
+     *
+     * @param index index of the item in the pool. Must fit in 32 bits
+     * @param generation generation of the item's slot
+     */
+    constexpr CompactHandle(std::uint32_t index, std::uint32_t generation):
+        value((static_cast<std::uint64_t>(generation) << GenerationShift) | index) {
+    }
+
+    /**
+     * @brief Recreate a handle from the value returned by Value()
+     *
+     * @param packedValue value of a handle
+     * @return CompactHandle the handle
+     */
+    static constexpr auto FromValue(std::uint64_t packedValue) -> CompactHandle {
+        return CompactHandle(packedValue);
+    }
+
+    /**
+     * @brief Returns the handle packed in a 64 bit word
+     *
+     */
+    constexpr auto Value() const -> std::uint64_t {
+        return this->value;
+    }
+
+    /**
+     * @brief Returns the index of the item in the pool
+     *
+     */
+    constexpr auto PoolIndex() const -> IndexSizeT {
+        return static_cast<std::uint32_t>(this->value);
+    }
+
+    /**
+     * @brief Returns the generation of the item's slot when the handle was created
+     *
+     */
+    constexpr auto Generation() const -> std::uint32_t {
+        return static_cast<std::uint32_t>(this->value >> GenerationShift);
+    }
+
+    /**
+     * @brief Returns true if this is an empty handle
+     *
+     */
+    constexpr auto Empty() const -> bool {
+        return this->value == EmptyValue;
+    }
+
+    constexpr auto operator==(const CompactHandle& other) const -> bool {
+        return this->value == other.value;
+    }
+
+    constexpr auto operator!=(const CompactHandle& other) const -> bool {
+        return this->value != other.value;
+    }
+};
+
+static_assert(sizeof(CompactHandle) == sizeof(std::uint64_t), "compact handles must fit in a machine word");
+
+class InvalidCompactHandleArgumentsError: public std::invalid_argument {
+    using std::invalid_argument::invalid_argument;
+};
+
+/**
+ * @brief Generation policy that doesn't keep slot generations. Pools using it don't provide MakeCompactHandle and Resolve,
+ * and returning an item doesn't touch any generation
+ *
+ */
+class NoGenerations final {
+  public:
+    static constexpr bool Enabled = false;
+
+    explicit NoGenerations(std::size_t /* numItems */) {
+    }
+
+    inline auto Retire(IndexSizeT /* index */) -> void {
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(NoGenerations);
+    ~NoGenerations() = default;
+};
+
+/**
+ * @brief Generation policy keeping a 32 bit generation per slot, incremented whenever the slot's item is returned,
+ * so pools using it can hand out CompactHandle references to their items.
+ *
+ * Returning an item costs an atomic increment on its slot's generation.
+ */
+class SlotGenerations final {
+  private:
+    std::unique_ptr<std::atomic<std::uint32_t>[]> generations;
+
+  public:
+    static constexpr bool Enabled = true;
+
+    /**
+     * @brief Construct a new set of slot generations, all starting at zero
+     *
+     * @param numItems number of items in the pool
+     * @throws InvalidCompactHandleArgumentsError if the pool indices don't fit in a compact handle
+     */
+    explicit SlotGenerations(std::size_t numItems) {
+        // the largest index is reserved for empty handles
+        if(numItems > std::numeric_limits<std::uint32_t>::max()) {
+            throw InvalidCompactHandleArgumentsError("Pools with compact handles must have less than 2^32 items");
+        }
+
+        this->generations.reset(new std::atomic<std::uint32_t>[numItems]);
+        for(std::size_t i = 0 ; i < numItems ; i++) {
+            this->generations[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Invalidate the compact handles of a slot whose item is being returned
+     *
+     */
+    inline auto Retire(IndexSizeT index) -> void {
+        this->generations[index].fetch_add(1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Returns the current generation of a slot
+     *
+     */
+    inline auto Current(IndexSizeT index) const -> std::uint32_t {
+        return this->generations[index].load(std::memory_order_acquire);
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(SlotGenerations);
+    ~SlotGenerations() = default;
+};
+
+} // namespace dxpool
+
+#endif // COMPACT_HANDLE_H
@@ -1,12 +1,14 @@
 #ifndef ATOMIC_INDEXER_H
 #define ATOMIC_INDEXER_H
 
+#include <algorithm>
 #include <atomic>
 #include <thread>
 #include <vector>
 #include <limits>
 
 #include "Optimizers.h"
+#include "PoolStats.h"
 #include "TypePolicies.h"
 #include "IndexHolder.h"
 
@@ -20,8 +22,11 @@ static const IndexSizeT UnusedPosition = 0;
 /**
  * @brief Lock-free indexer
  *
+ * @tparam StatsPolicy statistics collected by the indexer, NoStats or ShardedStats. With ShardedStats the indexer
+ *         also counts compare and swap retries and the iterations spent waiting for slots being written or read by other threads
  */
-class ConcurrentIndexer final {
+template<typename StatsPolicy = NoStats>
+class BasicConcurrentIndexer final {
   private:
 
 
@@ -36,6 +41,8 @@ class ConcurrentIndexer final {
      */
     IndexSizeT maxPositionSize{0};
 
+    StatsPolicy stats;
+
 
     /**
      * @brief Helper function wrapping a non C++ atomic load operation
@@ -73,6 +80,64 @@ class ConcurrentIndexer final {
         }
     }
 
+    /**
+     * @brief Read and clear the index stored in a slot whose read position has already been claimed
+     *
+     * @param slot position in the index vector
+     * @return IndexSizeT the index stored in the slot
+     */
+    inline auto ConsumeSlot(IndexSizeT slot) -> IndexSizeT {
+        IndexSizeT index = AtomicLoad(&this->indices[slot]);
+        // It's possible we got here because we wrapped but the thread writing to this position
+        // hasn't finished doing so yet. We try to keep the behaviour correct via busy wait
+        // This situation could happen if the size is much smaller than the number of threads calling it
+        while(index == UnusedPosition) {
+            index = AtomicLoad(&this->indices[slot]);
+            std::this_thread::yield();
+            this->stats.Add(PoolStat::Spins, 1);
+        }
+
+        AtomicStore(&this->indices[slot],  UnusedPosition);
+
+        return index-1;
+    }
+
+    /**
+     * @brief Store an index in a slot whose write position has already been claimed
+     *
+     * @param slot position in the index vector
+     * @param index the index being returned
+     */
+    inline auto FillSlot(IndexSizeT slot, IndexSizeT index) -> void {
+        // As in the read position, various threads could get here and slot will wrap to the same position in the vector
+        // and we try to correct it later when writing the value back
+        while(AtomicLoad(&this->indices[slot]) != UnusedPosition) {
+            std::this_thread::yield();
+            this->stats.Add(PoolStat::Spins, 1);
+        }
+
+        // add back 1 that was subtracted before
+        AtomicStore(&this->indices[slot], index+1);
+    }
+
+    /**
+     * @brief Record indices taken and the number of indices in use after moving the read position to newReadPos
+     *
+     */
+    inline auto RecordTaken(IndexSizeT newReadPos, IndexSizeT taken) -> void {
+        if(!StatsPolicy::Enabled) {
+            return;
+        }
+
+        this->stats.Add(PoolStat::Taken, taken);
+
+        // both positions may have moved since, so this is an estimate that's exact when there's no concurrent access
+        const IndexSizeT curWritePos = this->writePos.load(std::memory_order_relaxed);
+        const IndexSizeT available = curWritePos >= newReadPos ? curWritePos - newReadPos : curWritePos + (this->maxPositionSize - newReadPos);
+        const IndexSizeT poolSize = this->size / 2;
+        this->stats.ObserveInUse(poolSize - std::min(available, poolSize));
+    }
+
   public:
     /**
      * @brief Construct a new Concurrent Indexer with a given size indicacting the maximum number of indices to hold
@@ -80,7 +145,7 @@ class ConcurrentIndexer final {
      *
      * @param poolSize number of possible indices.
      */
-    ConcurrentIndexer(IndexSizeT poolSize):size(poolSize*2), maxPositionSize((std::numeric_limits<IndexSizeT>::max()/this->size) * this->size) {
+    BasicConcurrentIndexer(IndexSizeT poolSize):size(poolSize*2), maxPositionSize((std::numeric_limits<IndexSizeT>::max()/this->size) * this->size) {
         // The idea is to have all possible indices given a max pool size tracked in this vector
         // when an element is requested from the pool, the index of the item in the pool is retrieved by returning
         // an index from indices starting from the read position.
@@ -125,6 +190,7 @@ class ConcurrentIndexer final {
 
                 // There's no more items to read because we read all nothing has been returned
                 if(curReadPos == curWritePos) {
+                    this->stats.Add(PoolStat::TakeFailures, 1);
                     return {};
                 }
 
@@ -137,25 +203,18 @@ class ConcurrentIndexer final {
                 // It's possible that writing (Return) has started (incremented writePos) but the value hasn't been written yet
                 // Note to self: this should never happen and if it does there might be a bug somewhere
                 if(unlikely(AtomicLoad(&this->indices[curReadIndex]) == UnusedPosition)) {
+                    this->stats.Add(PoolStat::TakeFailures, 1);
                     return {};
                 }
 
                 auto modified = this->readPos.compare_exchange_weak(curReadPos, curReadPos + 1, std::memory_order_acq_rel);
 
                 if(modified) {
-                    IndexSizeT index = AtomicLoad(&this->indices[curReadIndex]);
-                    // It's possible we got here because we wrapped but the thread writing to this position
-                    // hasn't finished doing so yet. We try to keep the behaviour correct via busy wait
-                    // This situation could happen if the size is much smaller than the number of threads calling it
-                    while(index == UnusedPosition) {
-                        index = AtomicLoad(&this->indices[curReadIndex]);
-                        std::this_thread::yield();
-                    }
-
-                    AtomicStore(&this->indices[curReadIndex],  UnusedPosition);
-
-                    return {index-1};
+                    this->RecordTaken(curReadPos + 1, 1);
+                    return {this->ConsumeSlot(curReadIndex)};
                 }
+
+                this->stats.Add(PoolStat::CASRetries, 1);
             }
         }
     }
@@ -178,30 +237,122 @@ class ConcurrentIndexer final {
                 auto modified = this->writePos.compare_exchange_weak(curWritePos, curWritePos+1, std::memory_order_acq_rel);
 
                 if(modified) {
-                    // As in the read position, various threads could get here and curWriteIndex will wrap to the same position in the vector
-                    // and we try to correct it later when writing the value back
-                    const IndexSizeT curWriteIndex = curWritePos % this->size;
+                    this->FillSlot(curWritePos % this->size, index);
+                    this->stats.Add(PoolStat::Returned, 1);
+                    return;
+                }
 
-                    while(AtomicLoad(&this->indices[curWriteIndex]) != UnusedPosition) {
-                        std::this_thread::yield();
+                this->stats.Add(PoolStat::CASRetries, 1);
+            }
+        }
+    }
+
+    /**
+     * @brief Get up to count available indices, advancing the read position once for the whole batch
+     *
+     * @param count maximum number of indices to retrieve
+     * @param outIndices destination of the retrieved indices. It must have space for at least count indices
+     * @return IndexSizeT number of indices written to outIndices. Zero if there are no more indices
+     */
+    auto Next(IndexSizeT count, IndexSizeT* outIndices) -> IndexSizeT {
+        if(count == 0) {
+            return 0;
+        }
+
+        while(true) {
+            IndexSizeT curReadPos = this->readPos.load(std::memory_order_acquire);
+
+            if(curReadPos == this->maxPositionSize) {
+                WrapOnOverflow(this->readPos, this->maxPositionSize);
+            } else {
+                const IndexSizeT curWritePos = this->writePos.load(std::memory_order_acquire);
+
+                if(curReadPos == curWritePos) {
+                    this->stats.Add(PoolStat::TakeFailures, 1);
+                    return 0;
+                }
+
+                if(unlikely(AtomicLoad(&this->indices[curReadPos % this->size]) == UnusedPosition)) {
+                    this->stats.Add(PoolStat::TakeFailures, 1);
+                    return 0;
+                }
+
+                // The write position may have already wrapped to zero, in which case we only claim
+                // positions up to the wrap point and leave the rest for the next call
+                const IndexSizeT available = curWritePos > curReadPos ? curWritePos - curReadPos : this->maxPositionSize - curReadPos;
+                const IndexSizeT taken = std::min(count, available);
+
+                if(this->readPos.compare_exchange_weak(curReadPos, curReadPos + taken, std::memory_order_acq_rel)) {
+                    this->RecordTaken(curReadPos + taken, taken);
+                    if(taken < count) {
+                        this->stats.Add(PoolStat::TakeFailures, 1);
                     }
 
-                    // add back 1 that was subtracted before
-                    AtomicStore(&this->indices[curWriteIndex], index+1);
+                    for(IndexSizeT i = 0 ; i < taken ; i++) {
+                        outIndices[i] = this->ConsumeSlot((curReadPos + i) % this->size); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    }
 
+                    return taken;
+                }
 
-                    return;
+                this->stats.Add(PoolStat::CASRetries, 1);
+            }
+        }
+    }
+
+    /**
+     * @brief Return a batch of indices to the pool, advancing the write position once for the whole batch
+     * (or twice, if the write position wraps in the middle of the batch).
+     * The same restrictions of Return(IndexSizeT) apply to every index in the batch.
+     *
+     * @param returnedIndices indices to be returned
+     * @param count number of indices in returnedIndices
+     */
+    auto Return(const IndexSizeT* returnedIndices, IndexSizeT count) -> void {
+        IndexSizeT returned = 0;
+
+        while(returned < count) {
+            auto curWritePos = this->writePos.load(std::memory_order_acquire);
+            if(curWritePos == this->maxPositionSize) {
+                WrapOnOverflow(this->writePos, this->maxPositionSize);
+            } else {
+                const IndexSizeT batchSize = std::min(count - returned, this->maxPositionSize - curWritePos);
+
+                if(this->writePos.compare_exchange_weak(curWritePos, curWritePos + batchSize, std::memory_order_acq_rel)) {
+                    for(IndexSizeT i = 0 ; i < batchSize ; i++) {
+                        this->FillSlot((curWritePos + i) % this->size, returnedIndices[returned + i]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    }
+
+                    returned += batchSize;
+                    this->stats.Add(PoolStat::Returned, batchSize);
+                } else {
+                    this->stats.Add(PoolStat::CASRetries, 1);
                 }
             }
         }
     }
 
-    FORBID_COPY_MOVE_ASSIGN(ConcurrentIndexer);
+    /**
+     * @brief Returns the statistics collected by the indexer. Empty when using NoStats
+     *
+     * @return PoolStatsSnapshot counter values
+     */
+    auto Stats() const -> PoolStatsSnapshot {
+        return this->stats.Snapshot();
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(BasicConcurrentIndexer);
 
-    ~ConcurrentIndexer() = default;
+    ~BasicConcurrentIndexer() = default;
 
 };
 
+/**
+ * @brief Lock-free indexer without statistics
+ *
+ */
+using ConcurrentIndexer = BasicConcurrentIndexer<NoStats>;
+
 
 } // namespace dxpool
 #endif
\ No newline at end of file
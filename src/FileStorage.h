@@ -0,0 +1,280 @@
+#ifndef FILE_STORAGE_H
+#define FILE_STORAGE_H
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "CacheLine.h"
+#include "IndexHolder.h"
+#include "MemoryMapping.h"
+#include "MutexIndexer.h"
+#include "Pool.h"
+#include "PoolStorage.h"
+#include "TypePolicies.h"
+
+namespace dxpool {
+
+class FileStorageError: public std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief Pool storage that maps a file as the item array, so that items outlive the process and a restarted
+ * process can attach to the same file and resume with its items warm.
+ *
+ * Next to the items, the file keeps one in use flag per item, set when the item is taken and cleared once it's
+ * reset and returned. When attaching to an existing file, items are left as they are and the items that were in use
+ * are kept out of the pool until taken with Pool::TakeRestored. A new file is created with default constructed items.
+ *
+ * Since the mapping is shared with the file, contents survive the process exiting or crashing, but are only written to disk
+ * as the kernel writes back dirty pages. A memfd can be used instead of a file through its /proc/self/fd path.
+ *
+ * Only one pool at a time may use a file. ItemType must be trivially copyable, and a file can only be attached by a
+ * storage with the same item size, alignment and number of items.
+ *
+ * @tparam ItemType type of the items stored
+ */
+template<typename ItemType>
+class FileStorage final {
+    static_assert(std::is_trivially_copyable<ItemType>::value, "items stored in a file must be trivially copyable");
+
+  public:
+    using StorageCategory = PoolStorageTag;
+
+  private:
+    static constexpr const std::uint64_t FileMagic = 0x6478706f6f6c4653ULL; // "dxpoolFS"
+    static constexpr const std::uint32_t FileVersion = 1;
+
+    struct FileHeader {
+        std::uint64_t magic;
+        std::uint32_t version;
+        std::uint32_t itemAlignment;
+        std::uint64_t itemSize;
+        std::uint64_t itemCount;
+        std::uint64_t itemsOffset;
+    };
+
+    /**
+     * @brief Open file descriptor, closed on destruction
+     *
+     */
+    class FileDescriptor final {
+      private:
+        int fd;
+
+      public:
+        explicit FileDescriptor(const std::string& path): fd(open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR)) { // NOLINT(cppcoreguidelines-pro-type-vararg, hicpp-vararg, hicpp-signed-bitwise)
+            if(this->fd < 0) {
+                throw FileStorageError("Unable to open " + path + ": " + std::strerror(errno)); // NOLINT(concurrency-mt-unsafe)
+            }
+        }
+
+        auto Get() const -> int {
+            return this->fd;
+        }
+
+        FORBID_COPY_MOVE_ASSIGN(FileDescriptor);
+
+        ~FileDescriptor() {
+            close(this->fd);
+        }
+    };
+
+    std::size_t numItems;
+    std::size_t itemsOffset;
+    bool created;
+    std::vector<IndexSizeT> restored;
+    MemoryMapping mapping;
+
+    static auto ItemsOffset(std::size_t storageSize) -> std::size_t {
+        const std::size_t alignment = alignof(ItemType) > DefaultCacheLineSize ? alignof(ItemType) : DefaultCacheLineSize;
+        const std::size_t flagsEnd = sizeof(FileHeader) + storageSize;
+        return (flagsEnd + alignment - 1) / alignment * alignment;
+    }
+
+    /**
+     * @brief Size the file for a new storage, or check that the file holds a storage with the same layout
+     *
+     * @return true if the file was empty and items must be created
+     */
+    static auto PrepareFile(const FileDescriptor& file, std::size_t fileSize) -> bool {
+        struct stat fileStat{};
+        if(fstat(file.Get(), &fileStat) != 0) {
+            throw FileStorageError(std::string("Unable to stat file: ") + std::strerror(errno)); // NOLINT(concurrency-mt-unsafe)
+        }
+
+        if(fileStat.st_size == 0) {
+            if(ftruncate(file.Get(), static_cast<off_t>(fileSize)) != 0) {
+                throw FileStorageError(std::string("Unable to resize file: ") + std::strerror(errno)); // NOLINT(concurrency-mt-unsafe)
+            }
+
+            return true;
+        }
+
+        if(static_cast<std::size_t>(fileStat.st_size) != fileSize) {
+            throw FileStorageError("File size doesn't match the storage size");
+        }
+
+        return false;
+    }
+
+    inline auto Header() const -> FileHeader* {
+        return static_cast<FileHeader*>(this->mapping.Data());
+    }
+
+    inline auto Flags() const -> unsigned char* {
+        return static_cast<unsigned char*>(this->mapping.Data()) + sizeof(FileHeader); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    inline auto ItemsBegin() const -> ItemType* {
+        return reinterpret_cast<ItemType*>(static_cast<unsigned char*>(this->mapping.Data()) + this->itemsOffset); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    auto CreateItems() -> void {
+        for(std::size_t i = 0 ; i < this->numItems ; i++) {
+            new (&this->ItemsBegin()[i]) ItemType(); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        // the header is written last, so a file only becomes attachable once fully initialized
+        *this->Header() = FileHeader{FileMagic, FileVersion, static_cast<std::uint32_t>(alignof(ItemType)), sizeof(ItemType), this->numItems, this->itemsOffset};
+    }
+
+    auto AttachItems() -> void {
+        const FileHeader* header = this->Header();
+        if(header->magic != FileMagic || header->version != FileVersion) {
+            throw FileStorageError("File doesn't hold a pool storage");
+        }
+
+        if(header->itemSize != sizeof(ItemType) || header->itemAlignment != alignof(ItemType) ||
+           header->itemCount != this->numItems || header->itemsOffset != this->itemsOffset) {
+            throw FileStorageError("File holds a pool storage with a different layout");
+        }
+
+        for(std::size_t i = 0 ; i < this->numItems ; i++) {
+            if(this->Flags()[i] != 0) { // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                this->restored.push_back(i);
+            }
+        }
+    }
+
+    FileStorage(std::size_t storageSize, const FileDescriptor& file):
+        numItems(storageSize), itemsOffset(ItemsOffset(storageSize)),
+        created(PrepareFile(file, this->itemsOffset + (storageSize * sizeof(ItemType)))),
+        mapping(file.Get(), this->itemsOffset + (storageSize * sizeof(ItemType))) {
+        if(this->created) {
+            this->CreateItems();
+        } else {
+            this->AttachItems();
+        }
+    }
+
+  public:
+    /**
+     * @brief Construct a new file storage, creating the file if it doesn't exist or is empty,
+     * or attaching to the items it holds otherwise
+     *
+     * @param storageSize number of items in the storage
+     * @param path path of the file
+     * @throws FileStorageError if the file cannot be opened or holds a storage with a different layout
+     * @throws MemoryMappingError if the file cannot be mapped
+     */
+    FileStorage(std::size_t storageSize, const std::string& path) noexcept(false):
+        FileStorage(storageSize, FileDescriptor(path)) {
+    }
+
+    /**
+     * @brief Returns the item at index
+     *
+     * @param index index of the item
+     * @return ItemType& reference to the item
+     */
+    inline auto operator[](IndexSizeT index) -> ItemType& {
+        return this->ItemsBegin()[index]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    /**
+     * @brief Returns the number of items in the storage
+     *
+     * @return std::size_t number of items
+     */
+    auto size() const -> std::size_t { // NOLINT(readability-identifier-naming)
+        return this->numItems;
+    }
+
+    /**
+     * @brief Flags the item at index as in use. Invoked by the pool before handing out the index
+     *
+     */
+    inline auto Acquire(IndexSizeT index) -> void {
+        this->Flags()[index] = 1; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    /**
+     * @brief Flags the item at index as free. Invoked by the pool once the item is reset, before its index goes back to the indexer
+     *
+     */
+    inline auto Release(IndexSizeT index) -> void {
+        this->Flags()[index] = 0; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    /**
+     * @brief Returns true if the item at index is flagged as in use
+     *
+     */
+    inline auto InUse(IndexSizeT index) const -> bool {
+        return this->Flags()[index] != 0; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    /**
+     * @brief Returns true if the file was created by this storage, false if the storage attached to existing items
+     *
+     */
+    auto Created() const -> bool {
+        return this->created;
+    }
+
+    /**
+     * @brief Indices of the items that were in use when the file was last detached, until taken by the pool
+     *
+     */
+    auto RestoredIndices() const -> const std::vector<IndexSizeT>& {
+        return this->restored;
+    }
+
+    /**
+     * @brief Forget the restored indices, once the pool has handed them out
+     *
+     */
+    auto ClearRestored() -> void {
+        this->restored.clear();
+        this->restored.shrink_to_fit();
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(FileStorage);
+    ~FileStorage() = default;
+};
+
+/**
+ * @brief Alias for a pool backed by a FileStorage. The size of the pool cannot be modified once created
+ *
+ * @tparam ItemType Type of the items in the pool, trivially copyable
+ * @tparam Indexer type of indexer to be used to when retrieving and returning objects.
+           The indexer defines the concurrency behaviour when using the pool in a multi-threaded context
+ */
+template<typename ItemType, typename Indexer = MutexIndexer>
+using FilePool= Pool<ItemType, FileStorage<ItemType>, Indexer>;
+
+} // namespace dxpool
+
+#endif // FILE_STORAGE_H
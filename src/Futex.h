@@ -0,0 +1,136 @@
+#ifndef FUTEX_H
+#define FUTEX_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+#include "TypePolicies.h"
+
+namespace dxpool {
+
+/**
+ * @brief A 32 bit wait word threads can sleep on until it changes, similar to C++20's std::atomic::wait.
+ *
+ * On Linux it's backed by a private futex, so waking up costs a system call only while there are sleeping threads.
+ * On other platforms it falls back to a mutex and condition variable.
+ */
+class Futex final {
+  private:
+    std::atomic<std::uint32_t> word{0};
+
+#ifdef __linux__
+    static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "futex word must be 32 bits");
+
+    auto WordAddress() -> std::uint32_t* {
+        return reinterpret_cast<std::uint32_t*>(&this->word); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+
+    auto SysWait(std::uint32_t expected, const timespec* timeout) -> void {
+        syscall(SYS_futex, this->WordAddress(), FUTEX_WAIT_PRIVATE, expected, timeout, nullptr, 0);
+    }
+#else
+    std::mutex mutex;
+    std::condition_variable condVar;
+#endif
+
+  public:
+    Futex() = default;
+
+    /**
+     * @brief Current value of the wait word
+     *
+     * @return std::uint32_t the value, to be passed to Wait or WaitFor
+     */
+    inline auto Value() const -> std::uint32_t {
+        return this->word.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Block the calling thread until notified, if the wait word still has the expected value.
+     * As with any condition variable, waits can end spuriously so callers must check their condition again
+     *
+     * @param expected value previously read with Value()
+     */
+    auto Wait(std::uint32_t expected) -> void {
+#ifdef __linux__
+        this->SysWait(expected, nullptr);
+#else
+        std::unique_lock<std::mutex> lock(this->mutex);
+        if(this->word.load(std::memory_order_acquire) == expected) {
+            this->condVar.wait(lock);
+        }
+#endif
+    }
+
+    /**
+     * @brief Block the calling thread until notified or the timeout elapses, if the wait word still has the expected value.
+     * Waits can end spuriously so callers must check their condition again
+     *
+     * @param expected value previously read with Value()
+     * @param timeout maximum time to wait
+     */
+    auto WaitFor(std::uint32_t expected, std::chrono::nanoseconds timeout) -> void {
+        if(timeout <= std::chrono::nanoseconds::zero()) {
+            return;
+        }
+
+#ifdef __linux__
+        const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+        timespec relativeTimeout{};
+        relativeTimeout.tv_sec = static_cast<time_t>(seconds.count());
+        relativeTimeout.tv_nsec = static_cast<long>((timeout - seconds).count()); // NOLINT(google-runtime-int)
+
+        this->SysWait(expected, &relativeTimeout);
+#else
+        std::unique_lock<std::mutex> lock(this->mutex);
+        if(this->word.load(std::memory_order_acquire) == expected) {
+            this->condVar.wait_for(lock, timeout);
+        }
+#endif
+    }
+
+    /**
+     * @brief Change the wait word and wake up to count waiting threads
+     *
+     * @param count maximum number of threads to wake up
+     */
+    auto Notify(std::uint32_t count) -> void {
+#ifdef __linux__
+        this->word.fetch_add(1, std::memory_order_release);
+
+        const auto wakeCount = static_cast<int>(std::min<std::uint32_t>(count, static_cast<std::uint32_t>(std::numeric_limits<int>::max())));
+        syscall(SYS_futex, this->WordAddress(), FUTEX_WAKE_PRIVATE, wakeCount, nullptr, nullptr, 0);
+#else
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->word.fetch_add(1, std::memory_order_release);
+        }
+
+        if(count == 1) {
+            this->condVar.notify_one();
+        } else {
+            this->condVar.notify_all();
+        }
+#endif
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(Futex);
+    ~Futex() = default;
+};
+
+} // namespace dxpool
+
+#endif // FUTEX_H
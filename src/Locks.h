@@ -0,0 +1,176 @@
+#ifndef LOCKS_H
+#define LOCKS_H
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "CacheLine.h"
+#include "Futex.h"
+#include "TypePolicies.h"
+
+namespace dxpool {
+
+/**
+ * @brief Number of times a lock is polled before the waiting thread yields (spin locks) or sleeps (AdaptiveLock)
+ *
+ */
+const constexpr int LockSpinLimit = 128;
+
+/**
+ * @brief Hint to the CPU that the thread is busy waiting, reducing power use and the cost of leaving the loop
+ *
+ */
+static inline auto CpuRelax() -> void {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield" ::: "memory");
+#endif
+}
+
+/**
+ * @brief Test and test and set spin lock.
+ *
+ * Waiting threads poll the lock with plain loads, which hit their own cache until the lock is released, and only then try
+ * to take it with an atomic exchange. Polling pauses the CPU between loads, and yields the thread every LockSpinLimit
+ * polls so that a preempted holder can run when there are more threads than cores.
+ *
+ * Meets the Lockable requirements, so it can be used with std::unique_lock and as the lock policy of BasicMutexIndexer.
+ */
+class TTASSpinLock final {
+  private:
+    std::atomic<bool> locked{false};
+
+  public:
+    TTASSpinLock() = default;
+
+    auto lock() -> void { // NOLINT(readability-identifier-naming)
+        int spins = 0;
+        while(this->locked.exchange(true, std::memory_order_acquire)) {
+            while(this->locked.load(std::memory_order_relaxed)) {
+                if(++spins < LockSpinLimit) {
+                    CpuRelax();
+                } else {
+                    spins = 0;
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }
+
+    auto try_lock() -> bool { // NOLINT(readability-identifier-naming)
+        return !this->locked.load(std::memory_order_relaxed) && !this->locked.exchange(true, std::memory_order_acquire);
+    }
+
+    auto unlock() -> void { // NOLINT(readability-identifier-naming)
+        this->locked.store(false, std::memory_order_release);
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(TTASSpinLock);
+    ~TTASSpinLock() = default;
+};
+
+/**
+ * @brief Ticket spin lock, granting the lock to waiting threads in the order they arrived.
+ *
+ * Each thread takes a ticket with a single atomic increment and waits until the ticket being served is its own,
+ * so waiting threads never compete for the lock with atomic operations and none of them can starve.
+ * The downside is that a preempted waiter holds back all threads behind it. Waiting pauses and yields as TTASSpinLock.
+ *
+ * Meets the Lockable requirements, so it can be used with std::unique_lock and as the lock policy of BasicMutexIndexer.
+ */
+class TicketLock final {
+  private:
+    alignas(DefaultCacheLineSize) std::atomic<std::uint32_t> nextTicket{0};
+    alignas(DefaultCacheLineSize) std::atomic<std::uint32_t> servingTicket{0};
+
+  public:
+    TicketLock() = default;
+
+    auto lock() -> void { // NOLINT(readability-identifier-naming)
+        const std::uint32_t ticket = this->nextTicket.fetch_add(1, std::memory_order_relaxed);
+
+        int spins = 0;
+        while(this->servingTicket.load(std::memory_order_acquire) != ticket) {
+            if(++spins < LockSpinLimit) {
+                CpuRelax();
+            } else {
+                spins = 0;
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    auto try_lock() -> bool { // NOLINT(readability-identifier-naming)
+        std::uint32_t ticket = this->servingTicket.load(std::memory_order_acquire);
+        return this->nextTicket.compare_exchange_strong(ticket, ticket + 1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    auto unlock() -> void { // NOLINT(readability-identifier-naming)
+        // only the holder modifies the ticket being served
+        this->servingTicket.store(this->servingTicket.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(TicketLock);
+    ~TicketLock() = default;
+};
+
+/**
+ * @brief Lock that spins for a short while and then sleeps on a Futex until the holder releases it.
+ *
+ * The lock state is unlocked, locked, or locked with possible sleepers. Threads that don't get the lock after
+ * LockSpinLimit polls mark it as having sleepers and wait on the futex, and unlocking only makes a wake up system call
+ * when the lock was marked. Short critical sections are handled by spinning, without parking threads in the kernel,
+ * while long waits don't burn the CPU.
+ *
+ * Meets the Lockable requirements, so it can be used with std::unique_lock and as the lock policy of BasicMutexIndexer.
+ */
+class AdaptiveLock final {
+  private:
+    static constexpr const std::uint32_t Unlocked = 0;
+    static constexpr const std::uint32_t Locked = 1;
+    static constexpr const std::uint32_t LockedWithSleepers = 2;
+
+    std::atomic<std::uint32_t> state{Unlocked};
+    Futex futex;
+
+  public:
+    AdaptiveLock() = default;
+
+    auto lock() -> void { // NOLINT(readability-identifier-naming)
+        for(int spins = 0 ; spins < LockSpinLimit ; spins++) {
+            if(this->try_lock()) {
+                return;
+            }
+
+            CpuRelax();
+        }
+
+        // the futex value is read before marking the lock, so an unlock in between changes it and the wait returns immediately
+        std::uint32_t futexValue = this->futex.Value();
+        while(this->state.exchange(LockedWithSleepers, std::memory_order_acquire) != Unlocked) {
+            this->futex.Wait(futexValue);
+            futexValue = this->futex.Value();
+        }
+    }
+
+    auto try_lock() -> bool { // NOLINT(readability-identifier-naming)
+        std::uint32_t expected = Unlocked;
+        return this->state.load(std::memory_order_relaxed) == Unlocked &&
+               this->state.compare_exchange_strong(expected, Locked, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    auto unlock() -> void { // NOLINT(readability-identifier-naming)
+        if(this->state.exchange(Unlocked, std::memory_order_release) == LockedWithSleepers) {
+            this->futex.Notify(1);
+        }
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(AdaptiveLock);
+    ~AdaptiveLock() = default;
+};
+
+} // namespace dxpool
+
+#endif // LOCKS_H
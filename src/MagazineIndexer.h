@@ -0,0 +1,255 @@
+#ifndef MAGAZINE_INDEXER_H
+#define MAGAZINE_INDEXER_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ConcurrentIndexer.h"
+#include "IndexHolder.h"
+#include "Optimizers.h"
+#include "TypePolicies.h"
+
+namespace dxpool {
+
+/**
+ * @brief Default number of indices cached per thread by a MagazineIndexer
+ *
+ */
+const constexpr IndexSizeT DefaultMagazineCapacity = 32;
+
+/**
+ * @brief Indexer that keeps a small per thread cache of indices (a magazine) in front of a shared indexer.
+ *
+ * Each thread using the indexer takes indices from and returns indices to its own magazine without touching any shared state.
+ * Only when the magazine is empty (on Next) or full (on Return) the thread accesses the shared indexer,
+ * refilling or flushing half of the magazine in a single batch operation.
+ *
+ * Indices cached in a thread's magazine are not visible to other threads, which means Next can return empty
+ * on one thread while other threads still hold free indices in their magazines.
+ * Magazines are drained back to the shared indexer when their thread exits.
+ *
+ * @tparam Indexer shared indexer used to refill and drain the magazines. It must support batch operations
+ * @tparam MagazineCapacity maximum number of indices cached per thread
+ */
+template<typename Indexer = ConcurrentIndexer, IndexSizeT MagazineCapacity = DefaultMagazineCapacity>
+class MagazineIndexer final {
+    static_assert(MagazineCapacity >= 2, "MagazineCapacity must be at least 2");
+
+  private:
+    static constexpr IndexSizeT TransferSize = MagazineCapacity / 2;
+
+    /**
+     * @brief State shared between the indexer and the magazines of all threads using it.
+     * Magazines of threads exiting after the indexer is destroyed will find a null indexer and simply discard their indices
+     */
+    struct MagazineOwner {
+        std::mutex mutex;
+        MagazineIndexer* indexer;
+    };
+
+    struct Magazine {
+        std::shared_ptr<MagazineOwner> owner;
+        std::uint64_t ownerID{0};
+        IndexSizeT count{0};
+        std::array<IndexSizeT, MagazineCapacity> indices{};
+    };
+
+    /**
+     * @brief All magazines of a thread, one per indexer instance used by the thread
+     *
+     */
+    struct ThreadMagazines {
+        std::vector<std::unique_ptr<Magazine>> magazines;
+        Magazine* last{nullptr};
+
+        ThreadMagazines() = default;
+        FORBID_COPY_MOVE_ASSIGN(ThreadMagazines);
+
+        ~ThreadMagazines() {
+            for(auto& magazine: this->magazines) {
+                MagazineIndexer::Drain(*magazine);
+            }
+        }
+    };
+
+    Indexer shared;
+    const std::uint64_t id;
+    std::shared_ptr<MagazineOwner> owner;
+
+    static auto NextID() -> std::uint64_t {
+        static std::atomic<std::uint64_t> nextID{1};
+        return nextID.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static auto LocalMagazines() -> ThreadMagazines& {
+        static thread_local ThreadMagazines threadMagazines;
+        return threadMagazines;
+    }
+
+    /**
+     * @brief Return all indices in a magazine to its shared indexer, if the indexer still exists
+     *
+     */
+    static auto Drain(Magazine& magazine) -> void {
+        std::lock_guard<std::mutex> lock(magazine.owner->mutex);
+        if(magazine.owner->indexer != nullptr && magazine.count > 0) {
+            magazine.owner->indexer->shared.Return(magazine.indices.data(), magazine.count);
+        }
+
+        magazine.count = 0;
+    }
+
+    static auto IsOwnerAlive(Magazine& magazine) -> bool {
+        std::lock_guard<std::mutex> lock(magazine.owner->mutex);
+        return magazine.owner->indexer != nullptr;
+    }
+
+    auto RegisterMagazine(ThreadMagazines& local) -> Magazine& {
+        for(auto& magazine: local.magazines) {
+            if(magazine->ownerID == this->id) {
+                local.last = magazine.get();
+                return *magazine;
+            }
+        }
+
+        // drop magazines of indexers that no longer exist before adding a new one
+        local.magazines.erase(std::remove_if(local.magazines.begin(), local.magazines.end(),
+        [](std::unique_ptr<Magazine>& magazine) {
+            return !MagazineIndexer::IsOwnerAlive(*magazine);
+        }), local.magazines.end());
+
+        std::unique_ptr<Magazine> magazine(new Magazine());
+        magazine->owner = this->owner;
+        magazine->ownerID = this->id;
+
+        local.magazines.push_back(std::move(magazine));
+        local.last = local.magazines.back().get();
+        return *local.last;
+    }
+
+    inline auto LocalMagazine() -> Magazine& {
+        ThreadMagazines& local = LocalMagazines();
+        if(likely(local.last != nullptr && local.last->ownerID == this->id)) {
+            return *local.last;
+        }
+
+        return this->RegisterMagazine(local);
+    }
+
+  public:
+    /**
+     * @brief Construct a new Magazine Indexer
+     *
+     * @param poolSize number of possible indices
+     */
+    MagazineIndexer(IndexSizeT poolSize): shared(poolSize), id(NextID()), owner(std::make_shared<MagazineOwner>()) {
+        this->owner->indexer = this;
+    }
+
+    /**
+     * @brief Get the next available index from the calling thread's magazine, refilling it from the shared indexer if empty.
+     * if there are no more indices, the returning IndexHolder will be empty
+     *
+     * @return IndexHolder next available index
+     */
+    auto Next() -> IndexHolder {
+        Magazine& magazine = this->LocalMagazine();
+
+        if(unlikely(magazine.count == 0)) {
+            magazine.count = this->shared.Next(TransferSize, magazine.indices.data());
+            if(magazine.count == 0) {
+                return {};
+            }
+        }
+
+        magazine.count--;
+        return {magazine.indices[magazine.count]};
+    }
+
+    /**
+     * @brief Return an index to the calling thread's magazine, flushing half of it to the shared indexer if full.
+     * There are no checks for validity of the index so callers must ensure the index is within the range of the pool
+     * and that they have not been previously returned.
+     */
+    auto Return(IndexSizeT index) -> void {
+        Magazine& magazine = this->LocalMagazine();
+
+        if(unlikely(magazine.count == MagazineCapacity)) {
+            magazine.count -= TransferSize;
+            this->shared.Return(&magazine.indices[magazine.count], TransferSize);
+        }
+
+        magazine.indices[magazine.count] = index;
+        magazine.count++;
+    }
+
+    /**
+     * @brief Get up to count available indices, first from the calling thread's magazine and then from the shared indexer
+     *
+     * @param count maximum number of indices to retrieve
+     * @param outIndices destination of the retrieved indices. It must have space for at least count indices
+     * @return IndexSizeT number of indices written to outIndices. Zero if there are no more indices
+     */
+    auto Next(IndexSizeT count, IndexSizeT* outIndices) -> IndexSizeT {
+        Magazine& magazine = this->LocalMagazine();
+
+        const IndexSizeT fromMagazine = std::min(count, magazine.count);
+        magazine.count -= fromMagazine;
+        std::copy_n(&magazine.indices[magazine.count], fromMagazine, outIndices);
+
+        if(fromMagazine == count) {
+            return count;
+        }
+
+        return fromMagazine + this->shared.Next(count - fromMagazine, &outIndices[fromMagazine]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    /**
+     * @brief Return a batch of indices, filling up the calling thread's magazine and sending the remaining ones to the shared indexer.
+     * The same restrictions of Return(IndexSizeT) apply to every index in the batch.
+     *
+     * @param returnedIndices indices to be returned
+     * @param count number of indices in returnedIndices
+     */
+    auto Return(const IndexSizeT* returnedIndices, IndexSizeT count) -> void {
+        Magazine& magazine = this->LocalMagazine();
+
+        const IndexSizeT toMagazine = std::min(count, MagazineCapacity - magazine.count);
+        std::copy_n(returnedIndices, toMagazine, &magazine.indices[magazine.count]);
+        magazine.count += toMagazine;
+
+        if(toMagazine < count) {
+            this->shared.Return(&returnedIndices[toMagazine], count - toMagazine); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+    }
+
+    /**
+     * @brief Return all indices cached in the calling thread's magazine to the shared indexer.
+     * This happens automatically when the thread exits but can be used to make the indices available to other threads earlier.
+     *
+     */
+    auto Flush() -> void {
+        Magazine& magazine = this->LocalMagazine();
+        this->shared.Return(magazine.indices.data(), magazine.count);
+        magazine.count = 0;
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(MagazineIndexer);
+
+    ~MagazineIndexer() {
+        std::lock_guard<std::mutex> lock(this->owner->mutex);
+        this->owner->indexer = nullptr;
+    }
+};
+
+template<typename Indexer, IndexSizeT MagazineCapacity>
+constexpr IndexSizeT MagazineIndexer<Indexer, MagazineCapacity>::TransferSize;
+
+} // namespace dxpool
+
+#endif // MAGAZINE_INDEXER_H
@@ -0,0 +1,155 @@
+#ifndef MAPPED_STORAGE_H
+#define MAPPED_STORAGE_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+#include "IndexHolder.h"
+#include "MemoryMapping.h"
+#include "MutexIndexer.h"
+#include "NUMANode.h"
+#include "Pool.h"
+#include "PoolStorage.h"
+#include "TypePolicies.h"
+
+namespace dxpool {
+
+/**
+ * @brief Pool storage that places items in an anonymous memory mapping rather than on the heap,
+ * with optional huge pages, pre-faulting and locking of the memory.
+ *
+ * Backing large pools with huge pages substantially reduces TLB misses when walking through items.
+ * When huge pages are not available the storage falls back to normal pages.
+ *
+ * As in LazyStorage, each item is constructed the first time its index is handed out by the pool, so creating the storage
+ * doesn't touch the mapping: pages are only faulted in as items are used, unless the mapping is populated up front,
+ * and transparent huge pages are applied on first touch. Items are destroyed with the storage.
+ * ItemType alignment must not exceed the system page size.
+ *
+ * @tparam ItemType type of the items stored
+ */
+template<typename ItemType>
+class MappedStorage final {
+  public:
+    using StorageCategory = PoolStorageTag;
+
+  private:
+    std::size_t numItems;
+    MemoryMapping mapping;
+    std::unique_ptr<bool[]> constructed;
+    ItemInitializer<ItemType> initializer;
+
+    inline auto ItemsBegin() const -> ItemType* {
+        return static_cast<ItemType*>(this->mapping.Data());
+    }
+
+  public:
+    /**
+     * @brief Construct a new mapped storage using normal pages
+     *
+     * @param storageSize number of items in the storage
+     */
+    MappedStorage(std::size_t storageSize): MappedStorage(storageSize, MappingOptions{}) {
+    }
+
+    /**
+     * @brief Construct a new mapped storage
+     *
+     * @param storageSize number of items in the storage
+     * @param options huge pages, population and locking options of the mapping
+     * @throws MemoryMappingError if memory cannot be mapped
+     */
+    MappedStorage(std::size_t storageSize, const MappingOptions& options) noexcept(false):
+        MappedStorage(storageSize, options, ConstructItemsWith<ItemType>()) {
+    }
+
+    /**
+     * @brief Construct a new mapped storage where items are created by an initializer
+     *
+     * @param storageSize number of items in the storage
+     * @param options huge pages, population and locking options of the mapping
+     * @param itemInitializer constructs each item the first time it's used
+     * @throws MemoryMappingError if memory cannot be mapped
+     */
+    MappedStorage(std::size_t storageSize, const MappingOptions& options, const ItemInitializer<ItemType>& itemInitializer) noexcept(false):
+        numItems(storageSize), mapping(storageSize * sizeof(ItemType), options), constructed(new bool[storageSize]()), initializer(itemInitializer) {
+    }
+
+    /**
+     * @brief Construct a new mapped storage using normal pages, with its memory bound to a NUMA node.
+     * Binding has no effect on systems with a single NUMA node
+     *
+     * @param storageSize number of items in the storage
+     * @param node NUMA node where item memory is allocated
+     * @throws MemoryMappingError if memory cannot be mapped
+     */
+    MappedStorage(std::size_t storageSize, const NUMANode& node) noexcept(false):
+        MappedStorage(storageSize, MappingOptions{}.OnNUMANode(node)) {
+    }
+
+    /**
+     * @brief Constructs the item at index if it hasn't been constructed yet.
+     * Invoked by the pool before handing out the index, which guarantees exclusive access to the item
+     *
+     * @param index index of the item
+     */
+    inline auto Acquire(IndexSizeT index) -> void {
+        if(!this->constructed[index]) {
+            this->initializer.Construct(&this->ItemsBegin()[index], index); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            this->constructed[index] = true;
+        }
+    }
+
+    /**
+     * @brief Returns the item at index. The item must have been acquired at least once
+     *
+     * @param index index of the item
+     * @return ItemType& reference to the item
+     */
+    inline auto operator[](IndexSizeT index) -> ItemType& {
+        return this->ItemsBegin()[index]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    /**
+     * @brief Returns the number of items in the storage
+     *
+     * @return std::size_t number of items
+     */
+    auto size() const -> std::size_t { // NOLINT(readability-identifier-naming)
+        return this->numItems;
+    }
+
+    /**
+     * @brief Returns the memory mapping holding the items
+     *
+     * @return const MemoryMapping& the mapping
+     */
+    auto Mapping() const -> const MemoryMapping& {
+        return this->mapping;
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(MappedStorage);
+
+    ~MappedStorage() {
+        for(std::size_t i = 0 ; i < this->numItems ; i++) {
+            if(this->constructed[i]) {
+                (*this)[i].~ItemType();
+            }
+        }
+    }
+};
+
+/**
+ * @brief Alias for a pool backed by a MappedStorage. The size of the pool cannot be modified once created
+ *
+ * @tparam ItemType Type of the items in the pool
+ * @tparam Indexer type of indexer to be used to when retrieving and returning objects.
+           The indexer defines the concurrency behaviour when using the pool in a multi-threaded context
+ */
+template<typename ItemType, typename Indexer = MutexIndexer>
+using MappedPool= Pool<ItemType, MappedStorage<ItemType>, Indexer>;
+
+} // namespace dxpool
+
+#endif // MAPPED_STORAGE_H
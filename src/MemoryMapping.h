@@ -0,0 +1,389 @@
+#ifndef MEMORY_MAPPING_H
+#define MEMORY_MAPPING_H
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "NUMAMemory.h"
+#include "NUMANode.h"
+#include "TypePolicies.h"
+
+namespace dxpool {
+
+class MemoryMappingError: public std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief Huge page usage of a memory mapping
+ *
+ */
+enum class HugePages {
+    /**
+     * @brief Only use the system's normal page size
+     */
+    None,
+    /**
+     * @brief Align the mapping to the huge page size and advise the kernel to back it with transparent huge pages
+     */
+    Transparent,
+    /**
+     * @brief Map explicit huge pages (MAP_HUGETLB) from the system's reserved huge page pool,
+     * falling back to transparent huge pages if none are available
+     */
+    Explicit
+};
+
+/**
+ * @brief Options for anonymous memory mappings
+ *
+ */
+class MappingOptions final {
+  private:
+    HugePages hugePages{HugePages::None};
+    bool populate{false};
+    bool lock{false};
+    NUMANode numaNode{};
+
+  public:
+    /**
+     * @brief Sets the huge page usage of the mapping
+     *
+     * @param mode huge page usage
+     * @return these options
+     */
+    auto WithHugePages(HugePages mode) -> MappingOptions& {
+        this->hugePages = mode;
+        return *this;
+    }
+
+    /**
+     * @brief Sets whether all pages are faulted in when the mapping is created rather than on first access
+     *
+     * @param prefault true to populate the mapping at creation
+     * @return these options
+     */
+    auto Populate(bool prefault) -> MappingOptions& {
+        this->populate = prefault;
+        return *this;
+    }
+
+    /**
+     * @brief Sets whether the mapping is locked in memory with mlock, which also populates it.
+     * Locking is best effort as it's subject to RLIMIT_MEMLOCK, see MemoryMapping::Locked
+     *
+     * @param lockPages true to lock the mapping in memory
+     * @return these options
+     */
+    auto Lock(bool lockPages) -> MappingOptions& {
+        this->lock = lockPages;
+        return *this;
+    }
+
+    /**
+     * @brief Binds the mapping to a NUMA node, so its pages are allocated on the node.
+     * Has no effect on systems with a single NUMA node
+     *
+     * @param node the NUMA node where memory will be allocated
+     * @return these options
+     */
+    auto OnNUMANode(const NUMANode& node) -> MappingOptions& {
+        this->numaNode = node;
+        return *this;
+    }
+
+    /**
+     * @brief Huge page usage of the mapping
+     *
+     * @return HugePages huge page mode
+     */
+    auto HugePageMode() const -> HugePages {
+        return this->hugePages;
+    }
+
+    /**
+     * @brief Whether the mapping is populated at creation
+     *
+     */
+    auto Populated() const -> bool {
+        return this->populate;
+    }
+
+    /**
+     * @brief Whether the mapping is locked in memory
+     *
+     */
+    auto Locked() const -> bool {
+        return this->lock;
+    }
+
+    /**
+     * @brief NUMA node the mapping is bound to. Empty if not bound to any node
+     *
+     */
+    auto TargetNUMANode() const -> const NUMANode& {
+        return this->numaNode;
+    }
+};
+
+/**
+ * @brief Owns an anonymous, private memory mapping, or a shared mapping of a file, unmapped on destruction
+ *
+ * Huge pages are used on a best effort basis: explicit huge pages fall back to transparent huge pages
+ * when the system has none reserved, and transparent huge pages silently use normal pages if disabled.
+ *
+ * When a NUMA node is requested, the mapping is bound to the node with mbind before any of its pages are faulted in.
+ */
+class MemoryMapping final {
+  private:
+    static constexpr const std::size_t DefaultHugePageSize = 2UL * 1024UL * 1024UL;
+    static constexpr const std::size_t BytesPerKB = 1024UL;
+
+    void* address{nullptr};
+    std::size_t length{0};
+    bool explicitHugePages{false};
+    bool locked{false};
+    bool boundToNode{false};
+
+    static auto RoundUp(std::size_t bytes, std::size_t multiple) -> std::size_t {
+        return (bytes + multiple - 1) / multiple * multiple;
+    }
+
+    static auto MapAnonymous(std::size_t bytes, int extraFlags) -> void* {
+        void* mapped = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | extraFlags, -1, 0); // NOLINT(hicpp-signed-bitwise)
+        return mapped == MAP_FAILED ? nullptr : mapped; // NOLINT(cppcoreguidelines-pro-type-cstyle-cast, performance-no-int-to-ptr)
+    }
+
+    /**
+     * @brief Map bytes starting at an address aligned to alignment, unmapping the unaligned head and tail of a larger mapping
+     *
+     */
+    static auto MapAligned(std::size_t bytes, std::size_t alignment) -> void* {
+        auto* mapped = static_cast<char*>(MemoryMapping::MapAnonymous(bytes + alignment, 0));
+        if(mapped == nullptr) {
+            return nullptr;
+        }
+
+        const auto start = reinterpret_cast<std::uintptr_t>(mapped); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        const std::size_t head = MemoryMapping::RoundUp(start, alignment) - start;
+        const std::size_t tail = alignment - head;
+
+        if(head > 0) {
+            munmap(mapped, head);
+        }
+
+        if(tail > 0) {
+            munmap(mapped + head + bytes, tail); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        return mapped + head; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    static auto Prefault(void* memory, std::size_t bytes) -> void {
+        const auto pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        auto* bytePtr = static_cast<volatile char*>(memory);
+
+        for(std::size_t offset = 0 ; offset < bytes ; offset += pageSize) {
+            bytePtr[offset] = 0; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+    }
+
+    auto MapTransparentHugePages(std::size_t bytes, bool populate) -> void {
+        const std::size_t hugePageSize = MemoryMapping::HugePageSize();
+        this->length = MemoryMapping::RoundUp(bytes, hugePageSize);
+        this->address = MemoryMapping::MapAligned(this->length, hugePageSize);
+
+        if(this->address == nullptr) {
+            return;
+        }
+
+#ifdef MADV_HUGEPAGE
+        madvise(this->address, this->length, MADV_HUGEPAGE);
+#endif
+
+        // MAP_POPULATE would fault the pages in before the advice is applied, so they are touched afterwards instead
+        if(populate) {
+            MemoryMapping::Prefault(this->address, this->length);
+        }
+    }
+
+    auto MapExplicitHugePages(std::size_t bytes, int populateFlag) -> void {
+#ifdef MAP_HUGETLB
+        this->length = MemoryMapping::RoundUp(bytes, MemoryMapping::HugePageSize());
+        this->address = MemoryMapping::MapAnonymous(this->length, MAP_HUGETLB | populateFlag); // NOLINT(hicpp-signed-bitwise)
+        this->explicitHugePages = this->address != nullptr;
+#else
+        (void)bytes;
+        (void)populateFlag;
+#endif
+    }
+
+  public:
+    /**
+     * @brief Returns the size of the default huge pages of the system, 2MB if it cannot be determined
+     *
+     * @return std::size_t huge page size in bytes
+     */
+    static auto HugePageSize() -> std::size_t {
+        static const std::size_t hugePageSize = []() -> std::size_t {
+            std::ifstream meminfo("/proc/meminfo");
+            std::string key;
+            std::size_t sizeKB = 0;
+
+            while(meminfo >> key) {
+                if(key == "Hugepagesize:" && meminfo >> sizeKB && sizeKB > 0) {
+                    return sizeKB * MemoryMapping::BytesPerKB;
+                }
+            }
+
+            return MemoryMapping::DefaultHugePageSize;
+        }();
+
+        return hugePageSize;
+    }
+
+    /**
+     * @brief Map at least bytes of zero initialized memory
+     *
+     * @param bytes minimum size of the mapping. No memory is mapped if zero
+     * @param options huge pages, population and locking options
+     * @throws MemoryMappingError if memory cannot be mapped, even with normal pages
+     */
+    MemoryMapping(std::size_t bytes, const MappingOptions& options) noexcept(false) {
+        if(bytes == 0) {
+            return;
+        }
+
+        // pages must only be faulted in once the mapping is bound to its node
+        const bool bindToNode = !options.TargetNUMANode().Empty() && NUMAMemory::IsNUMASystem();
+
+        int populateFlag = 0;
+#ifdef MAP_POPULATE
+        if(options.Populated() && !bindToNode) {
+            populateFlag = MAP_POPULATE;
+        }
+#endif
+
+        if(options.HugePageMode() == HugePages::Explicit) {
+            this->MapExplicitHugePages(bytes, populateFlag);
+        }
+
+        if(this->address == nullptr && options.HugePageMode() != HugePages::None) {
+            this->MapTransparentHugePages(bytes, options.Populated() && !bindToNode);
+        }
+
+        if(this->address == nullptr) {
+            const auto pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+            this->length = MemoryMapping::RoundUp(bytes, pageSize);
+            this->address = MemoryMapping::MapAnonymous(this->length, populateFlag);
+        }
+
+        if(this->address == nullptr) {
+            throw MemoryMappingError(std::string("Unable to map memory: ") + std::strerror(errno)); // NOLINT(concurrency-mt-unsafe)
+        }
+
+        if(bindToNode) {
+            this->boundToNode = NUMAMemory::BindToNode(this->address, this->length, options.TargetNUMANode().GetID());
+
+            if(options.Populated()) {
+                MemoryMapping::Prefault(this->address, this->length);
+            }
+        }
+
+        if(options.Locked()) {
+            this->locked = mlock(this->address, this->length) == 0;
+        }
+    }
+
+    /**
+     * @brief Map bytes of a file, shared with every other mapping of the file so that writes reach the file.
+     * The file must be at least bytes long and the descriptor can be closed once mapped
+     *
+     * @param fileDescriptor descriptor of the file, opened for reading and writing
+     * @param bytes size of the mapping. No memory is mapped if zero
+     * @throws MemoryMappingError if the file cannot be mapped
+     */
+    MemoryMapping(int fileDescriptor, std::size_t bytes) noexcept(false) {
+        if(bytes == 0) {
+            return;
+        }
+
+        void* mapped = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0); // NOLINT(hicpp-signed-bitwise)
+        if(mapped == MAP_FAILED) { // NOLINT(cppcoreguidelines-pro-type-cstyle-cast, performance-no-int-to-ptr)
+            throw MemoryMappingError(std::string("Unable to map file: ") + std::strerror(errno)); // NOLINT(concurrency-mt-unsafe)
+        }
+
+        this->address = mapped;
+        this->length = bytes;
+    }
+
+    /**
+     * @brief Start of the mapped memory, aligned to at least the system page size
+     *
+     * @return void* mapped memory or nullptr if the mapping is empty
+     */
+    auto Data() const -> void* {
+        return this->address;
+    }
+
+    /**
+     * @brief Size of the mapped memory, which is rounded up to the page size used
+     *
+     * @return std::size_t size in bytes
+     */
+    auto Size() const -> std::size_t {
+        return this->length;
+    }
+
+    /**
+     * @brief Whether the memory is backed by explicit huge pages.
+     * Transparent huge pages are managed by the kernel and not reported here
+     *
+     */
+    auto UsesExplicitHugePages() const -> bool {
+        return this->explicitHugePages;
+    }
+
+    /**
+     * @brief Whether the memory was successfully locked with mlock
+     *
+     */
+    auto Locked() const -> bool {
+        return this->locked;
+    }
+
+    /**
+     * @brief Whether the memory is bound to the NUMA node requested in the mapping options.
+     * Always false on single node systems, where binding has no effect
+     *
+     */
+    auto BoundToNUMANode() const -> bool {
+        return this->boundToNode;
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(MemoryMapping);
+
+    ~MemoryMapping() {
+        if(this->address == nullptr) {
+            return;
+        }
+
+        if(this->locked) {
+            munlock(this->address, this->length);
+        }
+
+        munmap(this->address, this->length);
+    }
+};
+
+} // namespace dxpool
+
+#endif // MEMORY_MAPPING_H
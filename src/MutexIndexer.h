@@ -1,10 +1,14 @@
 #ifndef MUTEX_INDEXER_H
 #define MUTEX_INDEXER_H
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <mutex>
 #include <vector>
 
 #include "IndexHolder.h"
+#include "Locks.h"
+#include "PoolStats.h"
 #include "TypePolicies.h"
 
 namespace dxpool {
@@ -13,12 +17,50 @@ namespace dxpool {
  * @brief Pool item indexer backed by a mutex for locking operations
  *
  * Pool indices start at 0
+ *
+ * @tparam StatsPolicy statistics collected by the indexer, NoStats or ShardedStats. With ShardedStats the indexer
+ *         also tracks lock contention, measuring the wait only when the lock is already held.
+ * @tparam LockPolicy lock protecting the indices, std::mutex by default. Any Lockable type can be used, such as
+ *         TTASSpinLock, TicketLock or AdaptiveLock, which avoid parking threads in the kernel for such a short critical section
  */
-class MutexIndexer final {
+template<typename StatsPolicy = NoStats, typename LockPolicy = std::mutex>
+class BasicMutexIndexer final {
   private:
-    std::mutex mutex;
+    LockPolicy mutex;
     std::vector<size_t> indices;
     size_t indexPos = 0;
+    StatsPolicy stats;
+
+    auto Lock() -> std::unique_lock<LockPolicy> {
+        if(!StatsPolicy::Enabled) {
+            return std::unique_lock<LockPolicy>(this->mutex);
+        }
+
+        std::unique_lock<LockPolicy> lock(this->mutex, std::try_to_lock);
+        if(!lock.owns_lock()) {
+            const auto waitStart = std::chrono::steady_clock::now();
+            lock.lock();
+            const auto waited = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - waitStart);
+
+            this->stats.Add(PoolStat::LockContentions, 1);
+            this->stats.Add(PoolStat::LockWaitNanos, static_cast<std::uint64_t>(waited.count()));
+        }
+
+        return lock;
+    }
+
+    // must be called while holding the lock
+    auto RecordNext(size_t taken, size_t requested) -> void {
+        if(taken > 0) {
+            this->stats.Add(PoolStat::Taken, taken);
+            this->stats.ObserveInUse(this->indexPos);
+        }
+
+        if(taken < requested) {
+            this->stats.Add(PoolStat::TakeFailures, 1);
+        }
+    }
+
   public:
     /**
      * @brief Construct a new Mutex Indexer object
@@ -26,7 +68,7 @@ class MutexIndexer final {
      *
      * @param maxSize number of indices. It must be greater than zero
      */
-    MutexIndexer(std::size_t maxSize) {
+    BasicMutexIndexer(std::size_t maxSize) {
         // The idea is to have all possible indices given a max pool size tracked in this vector
         // when an element is requested from the pool, the index of the item in the pool is retrieved by returning
         // an index from indices starting from the lowest position.
@@ -46,14 +88,16 @@ class MutexIndexer final {
      * @return std::size_t next available index
      */
     auto Next() -> IndexHolder {
-        std::lock_guard<std::mutex> lock(mutex);
+        const auto lock = this->Lock();
 
         if(this->indexPos == this->indices.size()) {
+            this->RecordNext(0, 1);
             return {};
         }
 
         const size_t index = indices[this->indexPos];
         this->indexPos++;
+        this->RecordNext(1, 1);
 
         return {index};
     }
@@ -65,15 +109,86 @@ class MutexIndexer final {
      * Returning more indices than the pool size will result in undefined behavior.
      */
     auto Return(size_t index) -> void {
-        std::lock_guard<std::mutex> lock(mutex);
+        const auto lock = this->Lock();
         this->indexPos--;
+        this->stats.Add(PoolStat::Returned, 1);
 
         indices[this->indexPos] = index;
     }
 
-    FORBID_COPY_MOVE_ASSIGN(MutexIndexer);
-    ~MutexIndexer() = default;
+    /**
+     * @brief Get up to count available indices, locking the indexer only once for the whole batch
+     *
+     * @param count maximum number of indices to retrieve
+     * @param outIndices destination of the retrieved indices. It must have space for at least count indices
+     * @return IndexSizeT number of indices written to outIndices. Zero if there are no more indices
+     */
+    auto Next(IndexSizeT count, IndexSizeT* outIndices) -> IndexSizeT {
+        const auto lock = this->Lock();
+
+        const IndexSizeT taken = std::min(count, this->indices.size() - this->indexPos);
+        for(IndexSizeT i = 0 ; i < taken ; i++) {
+            outIndices[i] = this->indices[this->indexPos + i]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        this->indexPos += taken;
+        this->RecordNext(taken, count);
+        return taken;
+    }
+
+    /**
+     * @brief Return a batch of indices to the pool, locking the indexer only once.
+     * The same restrictions of Return(size_t) apply to every index in the batch.
+     *
+     * @param returnedIndices indices to be returned
+     * @param count number of indices in returnedIndices
+     */
+    auto Return(const IndexSizeT* returnedIndices, IndexSizeT count) -> void {
+        const auto lock = this->Lock();
+        this->stats.Add(PoolStat::Returned, count);
+
+        for(IndexSizeT i = 0 ; i < count ; i++) {
+            this->indexPos--;
+            this->indices[this->indexPos] = returnedIndices[i]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+    }
+
+    /**
+     * @brief Returns the statistics collected by the indexer. Empty when using NoStats
+     *
+     * @return PoolStatsSnapshot counter values
+     */
+    auto Stats() const -> PoolStatsSnapshot {
+        return this->stats.Snapshot();
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(BasicMutexIndexer);
+    ~BasicMutexIndexer() = default;
 };
 
+/**
+ * @brief Mutex indexer without statistics
+ *
+ */
+using MutexIndexer = BasicMutexIndexer<NoStats>;
+
+/**
+ * @brief Indexer protected by a test and test and set spin lock, without statistics
+ *
+ */
+using SpinLockIndexer = BasicMutexIndexer<NoStats, TTASSpinLock>;
+
+/**
+ * @brief Indexer protected by a ticket lock, without statistics
+ *
+ */
+using TicketLockIndexer = BasicMutexIndexer<NoStats, TicketLock>;
+
+/**
+ * @brief Indexer protected by a lock spinning before sleeping on a futex, without statistics
+ *
+ */
+using AdaptiveLockIndexer = BasicMutexIndexer<NoStats, AdaptiveLock>;
+
 } // namespace dxpool
 #endif
\ No newline at end of file
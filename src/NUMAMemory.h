@@ -0,0 +1,202 @@
+#ifndef NUMA_MEMORY_H
+#define NUMA_MEMORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace dxpool {
+
+/**
+ * @brief NUMA memory placement via raw system calls, without requiring libnuma.
+ *
+ * On platforms other than Linux, or when the system has a single NUMA node, binding memory does nothing.
+ */
+class NUMAMemory final {
+  private:
+    static constexpr const int BindPolicy = 2; // MPOL_BIND
+    static constexpr const unsigned int MoveExistingPagesFlag = 1U << 1U; // MPOL_MF_MOVE
+    static constexpr const unsigned int BitsPerMaskWord = sizeof(unsigned long) * 8; // NOLINT(google-runtime-int)
+
+    /**
+     * @brief Parse a kernel node list such as "0-1,4" into node IDs
+     *
+     */
+    static auto ParseNodeList(const std::string& nodeList) -> std::vector<unsigned int> {
+        std::vector<unsigned int> nodes;
+        std::size_t position = 0;
+
+        while(position < nodeList.size()) {
+            std::size_t end = nodeList.find(',', position);
+            if(end == std::string::npos) {
+                end = nodeList.size();
+            }
+
+            const std::string range = nodeList.substr(position, end - position);
+            const std::size_t dash = range.find('-');
+
+            try {
+                const auto first = static_cast<unsigned int>(std::stoul(range.substr(0, dash)));
+                const auto last = dash == std::string::npos ? first : static_cast<unsigned int>(std::stoul(range.substr(dash + 1)));
+
+                for(unsigned int node = first ; node <= last ; node++) {
+                    nodes.push_back(node);
+                }
+            } catch(const std::exception&) {
+                return {};
+            }
+
+            position = end + 1;
+        }
+
+        return nodes;
+    }
+
+  public:
+    /**
+     * @brief Returns the IDs of the NUMA nodes online in the system. Empty if they cannot be determined
+     *
+     * @return std::vector<unsigned int> online node IDs, in ascending order
+     */
+    static auto OnlineNodes() -> std::vector<unsigned int> {
+        static const std::vector<unsigned int> onlineNodes = []() -> std::vector<unsigned int> {
+            std::ifstream online("/sys/devices/system/node/online");
+            std::string nodeList;
+
+            if(!(online >> nodeList)) {
+                return {};
+            }
+
+            return NUMAMemory::ParseNodeList(nodeList);
+        }();
+
+        return onlineNodes;
+    }
+
+    /**
+     * @brief Determines if the system has more than one NUMA node, in which case binding memory has an effect
+     *
+     * @return true if there are multiple NUMA nodes online
+     */
+    static auto IsNUMASystem() -> bool {
+        return NUMAMemory::OnlineNodes().size() > 1;
+    }
+
+    /**
+     * @brief Returns the NUMA node of the CPU the calling thread is running on
+     *
+     * @return int node ID, or a negative value if unknown
+     */
+    static inline auto CurrentNode() -> int {
+#ifdef __linux__
+        unsigned int cpuID{0};
+        unsigned int nodeID{0};
+        if(getcpu(&cpuID, &nodeID) == 0) {
+            return static_cast<int>(nodeID);
+        }
+#endif
+        return -1;
+    }
+
+    /**
+     * @brief Returns the relative distance between two NUMA nodes as reported by the kernel.
+     * If not available, nodes with closer IDs are considered closer
+     *
+     * @param fromNodeID source node
+     * @param toNodeID destination node
+     * @return unsigned int distance between nodes, where a node's distance to itself is the lowest
+     */
+    static auto Distance(unsigned int fromNodeID, unsigned int toNodeID) -> unsigned int {
+        constexpr const unsigned int LocalDistance = 10;
+        constexpr const unsigned int RemoteDistance = 20;
+
+        const auto nodes = NUMAMemory::OnlineNodes();
+        std::ifstream distances("/sys/devices/system/node/node" + std::to_string(fromNodeID) + "/distance");
+        unsigned int distance = 0;
+
+        for(const auto node: nodes) {
+            if(!(distances >> distance)) {
+                break;
+            }
+
+            if(node == toNodeID) {
+                return distance;
+            }
+        }
+
+        if(fromNodeID == toNodeID) {
+            return LocalDistance;
+        }
+
+        return RemoteDistance + (fromNodeID > toNodeID ? fromNodeID - toNodeID : toNodeID - fromNodeID);
+    }
+
+    /**
+     * @brief Bind a page aligned memory range to a NUMA node. Pages already faulted in are moved to the node,
+     * pages faulted in later are allocated on the node.
+     *
+     * @param memory start of the range, aligned to the page size
+     * @param bytes size of the range
+     * @param nodeID target NUMA node
+     * @return true if the memory policy was applied
+     * @return false on single node systems, unsupported platforms or if the policy could not be applied
+     */
+    static auto BindToNode(void* memory, std::size_t bytes, unsigned int nodeID) -> bool {
+#ifdef SYS_mbind
+        if(!NUMAMemory::IsNUMASystem() || memory == nullptr || bytes == 0) {
+            return false;
+        }
+
+        std::vector<unsigned long> nodeMask(nodeID / BitsPerMaskWord + 1, 0); // NOLINT(google-runtime-int)
+        nodeMask[nodeID / BitsPerMaskWord] |= 1UL << (nodeID % BitsPerMaskWord);
+
+        // the kernel ignores the last bit of maxnode
+        const unsigned long maxNode = nodeMask.size() * BitsPerMaskWord + 1; // NOLINT(google-runtime-int)
+        return syscall(SYS_mbind, memory, bytes, BindPolicy, nodeMask.data(), maxNode, MoveExistingPagesFlag) == 0;
+#else
+        (void)memory;
+        (void)bytes;
+        (void)nodeID;
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Returns the NUMA node where the page holding an address resides.
+     * The page must have been faulted in.
+     *
+     * @param address address to locate
+     * @return int node ID, or a negative value if unknown
+     */
+    static auto NodeOfAddress(const void* address) -> int {
+#ifdef SYS_move_pages
+        const auto pageSize = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+        const auto pageStart = reinterpret_cast<std::uintptr_t>(address) / pageSize * pageSize; // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        void* page = reinterpret_cast<void*>(pageStart); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast, performance-no-int-to-ptr)
+        int status = -1;
+
+        // with no target nodes, move_pages only reports where each page is
+        if(syscall(SYS_move_pages, 0, 1UL, &page, nullptr, &status, 0) != 0) {
+            return -1;
+        }
+
+        return status;
+#else
+        (void)address;
+        return -1;
+#endif
+    }
+};
+
+} // namespace dxpool
+
+#endif // NUMA_MEMORY_H
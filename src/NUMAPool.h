@@ -0,0 +1,318 @@
+#ifndef NUMA_POOL_H
+#define NUMA_POOL_H
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "AlignedMemory.h"
+#include "MappedStorage.h"
+#include "MutexIndexer.h"
+#include "NUMAMemory.h"
+#include "NUMANode.h"
+#include "Optimizers.h"
+#include "Pool.h"
+#include "PoolItem.h"
+#include "PoolStats.h"
+#include "Processor.h"
+#include "ResetModes.h"
+#include "ResetPolicies.h"
+#include "TypePolicies.h"
+
+namespace dxpool {
+
+class InvalidNUMAPoolArgumentsError: public std::invalid_argument {
+    using std::invalid_argument::invalid_argument;
+};
+
+/**
+ * @brief A thread safe data and object pool with one shard of items per NUMA node
+ *
+ * Each shard is a BasicPool backed by a MappedStorage bound to the shard's node, created by a thread with affinity
+ * to the node's cores, so Take and Return on the local shard only touch local memory.
+ * Items are taken from the shard of the NUMA node the calling thread is running on and, when that shard is empty,
+ * from the other shards in order of NUMA distance. Items and handles are those of the shard they were taken from,
+ * so they are always returned to it, and the statistics, occupancy and reset mode of each shard work as in any pool.
+ *
+ * ItemType must be default constructible and its destructor is only invoked when the pool is destroyed.
+ *
+ * A pool cannot be copied or moved.
+ *
+ * @tparam ItemType type of the data to be stored
+ * @tparam Indexer type of indexer used by each shard
+ * @tparam ResetPolicy functor resetting items, as in BasicPool
+ * @tparam StatsPolicy statistics collected by each shard, NoStats or ShardedStats. See Shard()
+ * @tparam ResetMode when items are reset: ResetOnReturn or ResetOnTake
+ * @tparam OccupancyPolicy tracking of the items taken from each shard: NoOccupancy or OccupancyBitmap. See Shard()
+ */
+template<typename ItemType, typename Indexer = MutexIndexer, typename ResetPolicy = DefaultReset<ItemType>, typename StatsPolicy = NoStats,
+         typename ResetMode = ResetOnReturn, typename OccupancyPolicy = NoOccupancy>
+class NUMAPool final {
+  public:
+    /**
+     * @brief Type of the items stored in the pool
+     *
+     */
+    using ValueType = ItemType;
+
+    /**
+     * @brief Type of the pool holding the items of each NUMA node
+     *
+     */
+    using ShardPool = BasicPool<ItemType, ResetPolicy, MappedStorage<ItemType>, Indexer, StatsPolicy, ResetMode, OccupancyPolicy>;
+
+    /**
+     * @brief Handle type returned by TakeHandle, bound to the shard the item was taken from
+     *
+     */
+    using Handle = typename ShardPool::Handle;
+
+  private:
+    static_assert(!std::is_same<ResetMode, BackgroundReset>::value, "NUMAPool shards reset items on return or on take");
+
+    using CustomResetCallbackT = std::function<void(ItemType*)>;
+
+    /**
+     * @brief Determines if the reset policy can be created from a reset callback, as CallbackReset
+     *
+     */
+    template<typename Policy>
+    using AcceptsResetCallback = std::is_constructible<Policy, const CustomResetCallbackT&>;
+
+    struct NodeShard {
+        // shard pools hold their indexer, which may be over-aligned
+        AlignedPtr<ShardPool> pool;
+        unsigned int nodeID;
+    };
+
+    const IndexSizeT shardSize;
+    std::vector<NodeShard> shards;
+
+    // shards in the order they are searched, indexed by the node ID of the calling thread
+    std::vector<std::vector<std::size_t>> routes;
+    std::vector<std::size_t> defaultRoute;
+
+    /**
+     * @brief Create a shard from a thread with affinity to the node's cores, so memory allocated by the indexer is local to the node
+     *
+     * @param node NUMA node of the shard
+     * @param args arguments following the shard size and the node in the shard pool constructor
+     */
+    template<typename... Args>
+    auto CreateShard(const NUMANode& node, const Args&... args) -> NodeShard {
+        AlignedPtr<ShardPool> pool;
+        std::exception_ptr error;
+
+        std::thread creator([this, &node, &pool, &error, &args...]() {
+            if(!node.Cores().empty()) {
+                Processor processor;
+                processor.SetThreadAffinity(node.Cores());
+            }
+
+            try {
+                pool = MakeAligned<ShardPool>(this->shardSize, node, args...);
+            } catch(...) {
+                error = std::current_exception();
+            }
+        });
+        creator.join();
+
+        if(error) {
+            std::rethrow_exception(error);
+        }
+
+        return {std::move(pool), node.GetID()};
+    }
+
+    template<typename... Args>
+    auto CreateShards(const std::set<NUMANode>& nodes, const Args&... args) -> void {
+        if(this->shardSize == 0 || nodes.empty()) {
+            throw InvalidNUMAPoolArgumentsError("Items per node must be greater than zero and at least one NUMA node is required");
+        }
+
+        for(const auto& node: nodes) {
+            this->shards.push_back(this->CreateShard(node, args...));
+        }
+
+        this->BuildRoutes();
+    }
+
+    auto BuildRoutes() -> void {
+        unsigned int maxNodeID = 0;
+        for(const auto& shard: this->shards) {
+            maxNodeID = std::max(maxNodeID, shard.nodeID);
+        }
+
+        for(const auto nodeID: NUMAMemory::OnlineNodes()) {
+            maxNodeID = std::max(maxNodeID, nodeID);
+        }
+
+        for(std::size_t i = 0 ; i < this->shards.size() ; i++) {
+            this->defaultRoute.push_back(i);
+        }
+
+        this->routes.resize(maxNodeID + 1);
+        for(unsigned int nodeID = 0 ; nodeID <= maxNodeID ; nodeID++) {
+            auto& route = this->routes[nodeID];
+            route = this->defaultRoute;
+
+            std::stable_sort(route.begin(), route.end(), [this, nodeID](std::size_t left, std::size_t right) {
+                return NUMAMemory::Distance(nodeID, this->shards[left].nodeID) < NUMAMemory::Distance(nodeID, this->shards[right].nodeID);
+            });
+        }
+    }
+
+    inline auto RouteOfCurrentThread() const -> const std::vector<std::size_t>& {
+        const int nodeID = NUMAMemory::CurrentNode();
+
+        if(likely(nodeID >= 0 && static_cast<std::size_t>(nodeID) < this->routes.size())) {
+            return this->routes[static_cast<std::size_t>(nodeID)];
+        }
+
+        return this->defaultRoute;
+    }
+
+  public:
+    /**
+     * @brief Construct a new NUMA pool with a shard on each NUMA node available to the calling thread
+     *
+     * @param itemsPerNode number of items in each shard. It must be greater than zero
+     * @throws InvalidNUMAPoolArgumentsError if the number of items per node is zero or no NUMA nodes are found
+     */
+    NUMAPool(IndexSizeT itemsPerNode) noexcept(false): NUMAPool(itemsPerNode, Processor().FindAvailableNumaNodes()) {
+    }
+
+    /**
+     * @brief Construct a new NUMA pool with a shard on each of the NUMA nodes given
+     *
+     * @param itemsPerNode number of items in each shard. It must be greater than zero
+     * @param nodes NUMA nodes where shards are created. At least one node is required
+     * @throws InvalidNUMAPoolArgumentsError if the number of items per node is zero or there are no nodes
+     */
+    NUMAPool(IndexSizeT itemsPerNode, const std::set<NUMANode>& nodes) noexcept(false): shardSize(itemsPerNode) {
+        this->CreateShards(nodes);
+    }
+
+    /**
+     * @brief Construct a new NUMA pool with a shard on each of the NUMA nodes given and a custom reset callback
+     *
+     * @param itemsPerNode number of items in each shard. It must be greater than zero
+     * @param nodes NUMA nodes where shards are created. At least one node is required
+     * @param resetCb item state reset callback to be invoked immediately before the item is returned to the pool
+     */
+    template<typename Policy = ResetPolicy, typename = typename std::enable_if<AcceptsResetCallback<Policy>::value>::type>
+    NUMAPool(IndexSizeT itemsPerNode, const std::set<NUMANode>& nodes, const CustomResetCallbackT& resetCb) noexcept(false)
+        : shardSize(itemsPerNode) {
+        this->CreateShards(nodes, resetCb);
+    }
+
+    /**
+     * @brief Remove and return an element from the shard of the calling thread's NUMA node
+     * or, if empty, from the nearest shard with items
+     *
+     * @return PoolItem<ItemType> will be empty if there are no more items in any shard
+     */
+    inline auto Take() -> PoolItem<ItemType> {
+        for(const auto shardIndex: this->RouteOfCurrentThread()) {
+            auto item = this->shards[shardIndex].pool->Take();
+
+            if(likely(!item.Empty())) {
+                return item;
+            }
+        }
+
+        return {};
+    }
+
+    /**
+     * @brief Remove and return an element wrapped in a handle bound to the shard it was taken from,
+     * from the shard of the calling thread's NUMA node or, if empty, from the nearest shard with items
+     *
+     * @return Handle will be empty if there are no more items in any shard
+     */
+    inline auto TakeHandle() -> Handle {
+        for(const auto shardIndex: this->RouteOfCurrentThread()) {
+            auto handle = this->shards[shardIndex].pool->TakeHandle();
+
+            if(likely(!handle.Empty())) {
+                return handle;
+            }
+        }
+
+        return {};
+    }
+
+    /**
+     * @brief Returns the NUMA node ID of the shard holding an item taken from this pool
+     *
+     * @param item address of the item, as returned by PoolItem::Get or Handle::Get
+     * @return unsigned int NUMA node ID
+     * @throws InvalidNUMAPoolArgumentsError if the item doesn't belong to any shard
+     */
+    auto NodeOf(const ItemType* item) const -> unsigned int {
+        const auto address = reinterpret_cast<std::uintptr_t>(item); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+        for(const auto& shard: this->shards) {
+            const auto& mapping = shard.pool->Storage().Mapping();
+            const auto begin = reinterpret_cast<std::uintptr_t>(mapping.Data()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+            if(address >= begin && address < begin + this->shardSize * sizeof(ItemType)) {
+                return shard.nodeID;
+            }
+        }
+
+        throw InvalidNUMAPoolArgumentsError("Item does not belong to the pool");
+    }
+
+    /**
+     * @brief Returns the pool of a shard, e.g. to read its statistics or walk the items in use
+     *
+     * @param shardIndex index of the shard, less than ShardCount()
+     * @return ShardPool& the shard's pool
+     */
+    auto Shard(std::size_t shardIndex) -> ShardPool& {
+        return *this->shards[shardIndex].pool;
+    }
+
+    /**
+     * @brief Returns the NUMA node ID of a shard
+     *
+     * @param shardIndex index of the shard, less than ShardCount()
+     * @return unsigned int NUMA node ID
+     */
+    auto ShardNode(std::size_t shardIndex) const -> unsigned int {
+        return this->shards[shardIndex].nodeID;
+    }
+
+    /**
+     * @brief Returns the number of shards, one per NUMA node
+     *
+     * @return size_t number of shards
+     */
+    auto ShardCount() const -> size_t {
+        return this->shards.size();
+    }
+
+    /**
+     * @brief Returns the total number of items in all shards
+     *
+     * @return size_t size of the pool
+     */
+    auto Size() const -> size_t {
+        return this->shards.size() * this->shardSize;
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(NUMAPool);
+    ~NUMAPool() = default;
+}; // class NUMAPool
+
+} // namespace dxpool
+
+#endif // NUMA_POOL_H
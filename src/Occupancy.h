@@ -0,0 +1,136 @@
+#ifndef OCCUPANCY_H
+#define OCCUPANCY_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "IndexHolder.h"
+#include "TypePolicies.h"
+
+namespace dxpool {
+
+/**
+ * @brief Occupancy policy that doesn't track which items are taken. Pools using it don't provide ForEachInUse and ForEachFree
+ *
+ */
+class NoOccupancy final {
+  public:
+    static constexpr bool Enabled = false;
+
+    explicit NoOccupancy(std::size_t /* numItems */) {
+    }
+
+    inline auto Set(IndexSizeT /* index */) -> void {
+    }
+
+    inline auto Clear(IndexSizeT /* index */) -> void {
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(NoOccupancy);
+    ~NoOccupancy() = default;
+};
+
+/**
+ * @brief Occupancy policy keeping one bit per item, set while the item is taken, in an array of atomic 64 bit words.
+ *
+ * Scanning loads one word for every 64 items, skips words with no bits of interest with a single comparison
+ * and finds each set bit with a count trailing zeros instruction, so sweeping a large, mostly free pool only
+ * touches the items in use.
+ *
+ * Taking and returning an item costs an atomic or/and on the item's word, which is shared by 64 neighbouring items.
+ */
+class OccupancyBitmap final {
+  private:
+    static constexpr unsigned BitsPerWord = 64;
+
+    std::size_t numBits;
+    std::size_t numWords;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> words;
+
+    static inline auto LowestBit(std::uint64_t word) -> unsigned {
+        return static_cast<unsigned>(__builtin_ctzll(word));
+    }
+
+    /**
+     * @brief Mask of the bits in a word that correspond to items in the pool
+     *
+     */
+    inline auto ValidBits(std::size_t wordIndex) const -> std::uint64_t {
+        const std::size_t remaining = this->numBits - (wordIndex * BitsPerWord);
+        return remaining >= BitsPerWord ? ~std::uint64_t{0} : (std::uint64_t{1} << remaining) - 1;
+    }
+
+    template<bool InUse, typename Fn>
+    inline auto Scan(Fn&& fn) const -> void {
+        for(std::size_t w = 0 ; w < this->numWords ; w++) {
+            std::uint64_t word = this->words[w].load(std::memory_order_acquire);
+            if(!InUse) {
+                word = ~word & this->ValidBits(w);
+            }
+
+            while(word != 0) {
+                fn(static_cast<IndexSizeT>((w * BitsPerWord) + LowestBit(word)));
+                word &= word - 1;
+            }
+        }
+    }
+
+  public:
+    static constexpr bool Enabled = true;
+
+    /**
+     * @brief Construct a new bitmap with all items free
+     *
+     * @param numItems number of items in the pool
+     */
+    explicit OccupancyBitmap(std::size_t numItems):
+        numBits(numItems), numWords((numItems + BitsPerWord - 1) / BitsPerWord), words(new std::atomic<std::uint64_t>[numWords]) {
+        for(std::size_t w = 0 ; w < this->numWords ; w++) {
+            this->words[w].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Mark an item as taken
+     *
+     */
+    inline auto Set(IndexSizeT index) -> void {
+        this->words[index / BitsPerWord].fetch_or(std::uint64_t{1} << (index % BitsPerWord), std::memory_order_release);
+    }
+
+    /**
+     * @brief Mark an item as free
+     *
+     */
+    inline auto Clear(IndexSizeT index) -> void {
+        this->words[index / BitsPerWord].fetch_and(~(std::uint64_t{1} << (index % BitsPerWord)), std::memory_order_release);
+    }
+
+    /**
+     * @brief Invoke fn with the index of every item marked as taken, in increasing order
+     *
+     */
+    template<typename Fn>
+    auto ForEachSet(Fn&& fn) const -> void {
+        this->Scan<true>(std::forward<Fn>(fn));
+    }
+
+    /**
+     * @brief Invoke fn with the index of every item marked as free, in increasing order
+     *
+     */
+    template<typename Fn>
+    auto ForEachClear(Fn&& fn) const -> void {
+        this->Scan<false>(std::forward<Fn>(fn));
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(OccupancyBitmap);
+    ~OccupancyBitmap() = default;
+};
+
+} // namespace dxpool
+
+#endif // OCCUPANCY_H
@@ -0,0 +1,162 @@
+#ifndef PADDED_STORAGE_H
+#define PADDED_STORAGE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+#include "CacheLine.h"
+#include "IndexHolder.h"
+#include "MutexIndexer.h"
+#include "Pool.h"
+#include "PoolStorage.h"
+#include "TypePolicies.h"
+
+namespace dxpool {
+
+/**
+ * @brief Distance in bytes between the start of consecutive items in a PaddedStorage
+ *
+ */
+class ItemStride final {
+  private:
+    std::size_t bytes;
+
+  public:
+    /**
+     * @brief Construct a new item stride
+     *
+     * @param strideBytes distance between consecutive items, in bytes
+     */
+    explicit ItemStride(std::size_t strideBytes): bytes(strideBytes) {
+    }
+
+    /**
+     * @brief Returns the stride in bytes
+     *
+     */
+    auto Bytes() const -> std::size_t {
+        return this->bytes;
+    }
+};
+
+/**
+ * @brief Pool storage that pads items so that no two items share a cache line.
+ *
+ * By default each item starts on its own cache line, with the line size detected at runtime (see CacheLineSize),
+ * and takes as many lines as its size requires. A larger stride can be given, e.g. twice the line size
+ * to also avoid interference from adjacent line prefetching.
+ *
+ * Items are default constructed when the storage is created and destroyed with it.
+ *
+ * @tparam ItemType type of the items stored
+ */
+template<typename ItemType>
+class PaddedStorage final {
+  public:
+    using StorageCategory = PoolStorageTag;
+
+  private:
+    std::size_t numItems;
+    std::size_t stride;
+    std::unique_ptr<unsigned char[]> memory;
+    unsigned char* itemsBegin{nullptr};
+
+    static auto RoundUp(std::size_t bytes, std::size_t multiple) -> std::size_t {
+        return (bytes + multiple - 1) / multiple * multiple;
+    }
+
+    auto DestroyItems(std::size_t count) -> void {
+        for(std::size_t i = 0 ; i < count ; i++) {
+            (*this)[i].~ItemType();
+        }
+    }
+
+  public:
+    /**
+     * @brief Construct a new padded storage where each item starts on a new cache line
+     *
+     * @param storageSize number of items in the storage
+     */
+    PaddedStorage(std::size_t storageSize): PaddedStorage(storageSize, ItemStride(RoundUp(sizeof(ItemType), CacheLineSize()))) {
+    }
+
+    /**
+     * @brief Construct a new padded storage with a custom stride between items.
+     * The storage is aligned to the cache line size and the stride is rounded up to be at least the size of ItemType
+     * and a multiple of its alignment
+     *
+     * @param storageSize number of items in the storage
+     * @param itemStride distance between the start of consecutive items
+     */
+    PaddedStorage(std::size_t storageSize, const ItemStride& itemStride):
+        numItems(storageSize), stride(RoundUp(std::max(itemStride.Bytes(), sizeof(ItemType)), alignof(ItemType))) {
+
+        const std::size_t alignment = std::max(CacheLineSize(), alignof(ItemType));
+        this->memory.reset(new unsigned char[this->numItems * this->stride + alignment]);
+
+        const auto start = reinterpret_cast<std::uintptr_t>(this->memory.get()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        this->itemsBegin = this->memory.get() + (RoundUp(start, alignment) - start); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+        std::size_t constructed = 0;
+        try {
+            for(; constructed < this->numItems ; constructed++) {
+                new (&(*this)[constructed]) ItemType();
+            }
+        } catch(...) {
+            this->DestroyItems(constructed);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Returns the item at index
+     *
+     * @param index index of the item
+     * @return ItemType& reference to the item
+     */
+    inline auto operator[](IndexSizeT index) -> ItemType& {
+        return *reinterpret_cast<ItemType*>(this->itemsBegin + index * this->stride); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    /**
+     * @brief Returns the number of items in the storage
+     *
+     * @return std::size_t number of items
+     */
+    auto size() const -> std::size_t { // NOLINT(readability-identifier-naming)
+        return this->numItems;
+    }
+
+    /**
+     * @brief Returns the distance in bytes between consecutive items
+     *
+     * @return std::size_t stride in bytes
+     */
+    auto Stride() const -> std::size_t {
+        return this->stride;
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(PaddedStorage);
+
+    ~PaddedStorage() {
+        this->DestroyItems(this->numItems);
+    }
+};
+
+/**
+ * @brief Alias for a pool backed by a PaddedStorage, where no two items share a cache line.
+ * The size of the pool cannot be modified once created
+ *
+ * @tparam ItemType Type of the items in the pool
+ * @tparam Indexer type of indexer to be used to when retrieving and returning objects.
+           The indexer defines the concurrency behaviour when using the pool in a multi-threaded context
+ */
+template<typename ItemType, typename Indexer = MutexIndexer>
+using PaddedPool= Pool<ItemType, PaddedStorage<ItemType>, Indexer>;
+
+} // namespace dxpool
+
+#endif // PADDED_STORAGE_H
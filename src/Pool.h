@@ -4,20 +4,38 @@
 #include <type_traits>
 #include <vector>
 #include <array>
+#include <algorithm>
 #include <functional>
+#include <chrono>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 
+#include "CompactHandle.h"
 #include "IndexHolder.h"
 #include "TypePolicies.h"
 #include "MutexIndexer.h"
+#include "Occupancy.h"
 #include "PoolItem.h"
+#include "PoolHandle.h"
+#include "PoolStats.h"
+#include "PoolStorage.h"
+#include "ResetModes.h"
+#include "ResetPolicies.h"
+#include "SharedPoolItem.h"
 
 namespace dxpool {
 
-template <typename MaybeResetable> auto IsResetableTypeCondition(char) -> decltype(std::declval<MaybeResetable>().Reset(), std::true_type {});
-template <typename MaybeResetable> auto IsResetableTypeCondition(...) -> std::false_type;
+template <typename MaybeWaitable> auto IsWaitableIndexerCondition(char) -> decltype(std::declval<MaybeWaitable&>().NextWait(), std::true_type {});
+template <typename MaybeWaitable> auto IsWaitableIndexerCondition(...) -> std::false_type;
 
-template <typename MaybeResetable>
-using IsResetableType = decltype(IsResetableTypeCondition<MaybeResetable>(0));
+/**
+ * @brief Determines if an indexer lets callers wait for indices, such as WaitableIndexer
+ *
+ */
+template <typename MaybeWaitable>
+using IsWaitableIndexer = decltype(IsWaitableIndexerCondition<MaybeWaitable>(0));
 
 
 
@@ -36,62 +54,371 @@ using IsResetableType = decltype(IsResetableTypeCondition<MaybeResetable>(0));
  *
  * A pool cannot be copied or moved.
  *
+ * Every aspect of the pool is a compile time policy. Pool, StaticPool and RuntimePool are aliases
+ * with the default policies.
+ *
  * @tparam ItemType type of the data to be stored
- * @tparam Indexer type of indexer to be used to when retrieving and returning objects.
+ * @tparam ResetPolicy functor resetting items, invoked with a pointer to the item: MemberReset, NoReset, CallbackReset
+ *         or any other type with such call operator. Being part of the type, the call can be inlined and empty resets elided
+ * @tparam StoragePolicy container holding the items, e.g. std::array, std::vector or a storage policy such as LazyStorage.
+ *         The size of static pools is taken from std::array
+ * @tparam IndexerPolicy type of indexer to be used to when retrieving and returning objects.
            The indexer defines the concurrency behaviour when using the pool in a multi-threaded context
- * @tparam FixedPoolSize size of the pool, if specified as fixed
+ * @tparam StatsPolicy statistics collected by the pool, NoStats or ShardedStats. See Stats()
+ * @tparam ResetMode when and by whom items are reset: ResetOnReturn, ResetOnTake or BackgroundReset
+ * @tparam OccupancyPolicy tracking of the items currently taken: NoOccupancy or OccupancyBitmap. See ForEachInUse
+ * @tparam GenerationPolicy slot generations for compact handles: NoGenerations or SlotGenerations. See MakeCompactHandle
  */
+template<typename ItemType, typename ResetPolicy = DefaultReset<ItemType>, typename StoragePolicy = std::vector<ItemType>,
+         typename IndexerPolicy = MutexIndexer, typename StatsPolicy = NoStats, typename ResetMode = ResetOnReturn,
+         typename OccupancyPolicy = NoOccupancy, typename GenerationPolicy = NoGenerations>
+class BasicPool final {
+  public:
+    /**
+     * @brief Type of the items stored in the pool
+     *
+     */
+    using ValueType = ItemType;
+
+    /**
+     * @brief Handle type returned by TakeHandle, bound to this pool type
+     *
+     */
+    using Handle = PoolHandle<BasicPool>;
+
+    /**
+     * @brief Reference counted handle type returned by TakeShared, bound to this pool type
+     *
+     */
+    using SharedItem = SharedPoolItem<BasicPool>;
 
-template<typename ItemType, typename ItemContainerType, typename Indexer = MutexIndexer, IndexSizeT FixedPoolSize = 0>
-class Pool final {
   private:
+    friend Handle;
+    friend SharedItem;
+
+    /**
+     * @brief Maximum number of indices requested from or returned to the indexer in a single batch operation
+     *
+     */
+    static constexpr IndexSizeT MaxIndexBatchSize = 256;
+
     using CustomResetCallbackT = std::function<void(ItemType*)>;
-    CustomResetCallbackT customResetCallback= [](ItemType*) {};
 
-    ItemContainerType items = {};
-    Indexer indexer;
+    /**
+     * @brief Determines if the reset policy can be created from a reset callback, as CallbackReset
+     *
+     */
+    template<typename Policy>
+    using AcceptsResetCallback = std::is_constructible<Policy, const CustomResetCallbackT&>;
+
+    ResetPolicy resetPolicy{};
+    StoragePolicy items = {};
+    IndexerPolicy indexer;
+    StatsPolicy stats;
+    OccupancyPolicy occupancy;
+    GenerationPolicy generations;
+
+    std::once_flag referenceCountsInit;
+    std::unique_ptr<std::atomic<std::uint32_t>[]> referenceCounts;
 
-    template<typename ResetableType,  typename std::enable_if<IsResetableType<ResetableType>::value>::type* = nullptr>
-    auto InvokeReset(ResetableType* item)-> void {
-        item->Reset();
+    // declared last so it's destroyed first, while items and indexer still exist for pending background resets
+    ResetMode resetMode{[this](const IndexSizeT* indices, IndexSizeT count) {
+        this->ResetAndReturn(indices, count);
+    }};
+
+    inline auto InvokeReset(ItemType* item) -> void {
+        this->resetPolicy(item);
     }
 
-    template<typename NonResetableType,  typename std::enable_if<!IsResetableType<NonResetableType>::value>::type* = nullptr>
-    auto InvokeReset(NonResetableType* item) -> void {
-        this->customResetCallback(item);
+    inline auto ItemAt(IndexSizeT index) -> ItemType* {
+        return &this->items[index];
     }
 
-  public:
     /**
-     * @brief Construct a new object Pool if ItemType is move constructible
+     * @brief Mark an item being returned as free and invalidate its compact handles, before its index can be taken again
+     *
+     */
+    inline auto RetireIndex(IndexSizeT index) -> void {
+        this->occupancy.Clear(index);
+        this->generations.Retire(index);
+    }
+
+    inline auto RetireIndices(const IndexSizeT* indices, IndexSizeT count) -> void {
+        for(IndexSizeT i = 0 ; i < count ; i++) {
+            this->occupancy.Clear(indices[i]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            this->generations.Retire(indices[i]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+    }
+
+    /**
+     * @brief Give the index of a clean item back to the indexer, through the storage release hook
      *
-     * @param numItems number of items in the pool
      */
-    template<typename CTORItemType = ItemType, typename = typename std::enable_if<std::is_move_constructible<CTORItemType>::value>::type>
-    Pool(std::size_t  numItems): indexer(numItems) {
+    inline auto ReleaseIndex(IndexSizeT index) -> void {
+        StorageHooks<StoragePolicy>::Release(this->items, index);
+        this->indexer.Return(index);
+        this->stats.Add(PoolStat::Returned, 1);
+    }
+
+    inline auto ReleaseIndices(const IndexSizeT* indices, IndexSizeT count) -> void {
+        for(IndexSizeT i = 0 ; i < count ; i++) {
+            StorageHooks<StoragePolicy>::Release(this->items, indices[i]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        this->indexer.Return(indices, count);
+        this->stats.Add(PoolStat::Returned, count);
+    }
+
+    template<typename Mode = ResetMode, typename std::enable_if<!std::is_same<Mode, BackgroundReset>::value>::type* = nullptr>
+    inline auto ReturnIndex(IndexSizeT index) -> void {
+        this->RetireIndex(index);
+
+        if(std::is_same<Mode, ResetOnReturn>::value) {
+            this->InvokeReset(this->ItemAt(index));
+        }
+
+        this->ReleaseIndex(index);
+    }
+
+    template<typename Mode = ResetMode, typename std::enable_if<std::is_same<Mode, BackgroundReset>::value>::type* = nullptr>
+    inline auto ReturnIndex(IndexSizeT index) -> void {
+        this->RetireIndex(index);
+        this->resetMode.Submit(index);
+    }
+
+    template<typename Mode = ResetMode, typename std::enable_if<!std::is_same<Mode, BackgroundReset>::value>::type* = nullptr>
+    inline auto ReturnIndices(const IndexSizeT* indices, IndexSizeT count) -> void {
+        this->RetireIndices(indices, count);
+
+        if(std::is_same<Mode, ResetOnReturn>::value) {
+            this->ResetAndReturn(indices, count);
+        } else {
+            this->ReleaseIndices(indices, count);
+        }
+    }
+
+    template<typename Mode = ResetMode, typename std::enable_if<std::is_same<Mode, BackgroundReset>::value>::type* = nullptr>
+    inline auto ReturnIndices(const IndexSizeT* indices, IndexSizeT count) -> void {
+        this->RetireIndices(indices, count);
+        this->resetMode.Submit(indices, count);
+    }
+
+    /**
+     * @brief Reset a batch of items and return their indices to the indexer
+     *
+     */
+    auto ResetAndReturn(const IndexSizeT* indices, IndexSizeT count) -> void {
+        for(IndexSizeT i = 0 ; i < count ; i++) {
+            this->InvokeReset(this->ItemAt(indices[i])); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        this->ReleaseIndices(indices, count);
+    }
+
+    template<typename Mode = ResetMode, typename std::enable_if<std::is_same<Mode, BackgroundReset>::value>::type* = nullptr>
+    auto ReserveResets() -> void {
+        this->resetMode.Reserve(this->Size());
+    }
+
+    template<typename Mode = ResetMode, typename std::enable_if<!std::is_same<Mode, BackgroundReset>::value>::type* = nullptr>
+    auto ReserveResets() -> void {
+    }
+
+    /**
+     * @brief Keep the items in use when a persistent storage was last detached out of the indexer, by taking
+     * every index and giving back only the free ones
+     *
+     */
+    template<typename Storage = StoragePolicy, typename std::enable_if<HasRestoredIndices<Storage>::value>::type* = nullptr>
+    auto RestoreIndexer() -> void {
+        if(this->items.RestoredIndices().empty()) {
+            return;
+        }
+
+        std::vector<IndexSizeT> freeIndices;
+        std::array<IndexSizeT, MaxIndexBatchSize> batchIndices{};
+        IndexSizeT taken = 0;
+
+        while((taken = this->indexer.Next(MaxIndexBatchSize, batchIndices.data())) > 0) {
+            for(IndexSizeT i = 0 ; i < taken ; i++) {
+                if(!this->items.InUse(batchIndices[i])) {
+                    freeIndices.push_back(batchIndices[i]);
+                }
+            }
+        }
+
+        if(!freeIndices.empty()) {
+            this->indexer.Return(freeIndices.data(), freeIndices.size());
+        }
+    }
+
+    template<typename Storage = StoragePolicy, typename std::enable_if<!HasRestoredIndices<Storage>::value>::type* = nullptr>
+    auto RestoreIndexer() -> void {
+    }
+
+    inline auto RecordTake(IndexSizeT taken, IndexSizeT requested) -> void {
+        if(taken > 0) {
+            this->stats.Add(PoolStat::Taken, taken);
+        }
+
+        if(taken < requested) {
+            this->stats.Add(PoolStat::TakeFailures, 1);
+        }
+    }
+
+    inline auto AddReference(IndexSizeT index) -> void {
+        this->referenceCounts[index].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    inline auto ReleaseReference(IndexSizeT index) -> void {
+        // acq_rel so that the last owner sees every write made through the other copies before resetting the item
+        if(this->referenceCounts[index].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            this->ReturnIndex(index);
+        }
+    }
+
+    inline auto ReferenceCount(IndexSizeT index) const -> std::uint32_t {
+        return this->referenceCounts[index].load(std::memory_order_relaxed);
+    }
+
+    inline auto AcquireIndex(IndexSizeT index) -> void {
+        try {
+            StorageHooks<StoragePolicy>::Acquire(this->items, index);
+        } catch(...) {
+            // e.g. the item constructor of a LazyStorage threw, the index goes back so the pool doesn't lose the slot
+            this->indexer.Return(index);
+            throw;
+        }
+
+        this->occupancy.Set(index);
+
+        if(std::is_same<ResetMode, ResetOnTake>::value) {
+            this->InvokeReset(this->ItemAt(index));
+        }
+    }
+
+    inline auto MakePoolItem(IndexHolder holder) -> PoolItem<ItemType> {
+        if(holder.Empty()) {
+            this->RecordTake(0, 1);
+            return {};
+        }
+
+        auto returnToPoolFn = [this](const PoolItem<ItemType>& item) -> void{
+            this->ReturnIndex(item.PoolIndex());
+        };
+
+        const auto index = holder.Get();
+        this->AcquireIndex(index);
+        this->RecordTake(1, 1);
+        return PoolItem<ItemType>(returnToPoolFn, this->ItemAt(index), index);
+    }
+
+    BasicPool(std::size_t numItems, std::false_type /* isPoolStorage */): indexer(numItems), occupancy(numItems), generations(numItems) {
         for(size_t i = 0 ; i < numItems ; i++) {
             this->items.emplace_back();
         }
+
+        this->ReserveResets();
     }
 
+    BasicPool(std::size_t numItems, std::true_type /* isPoolStorage */): items(numItems), indexer(numItems), occupancy(numItems), generations(numItems) {
+        this->ReserveResets();
+        this->RestoreIndexer();
+    }
+
+  public:
     /**
-    * @brief Construct a new object Pool if ItemType is move constructible
+     * @brief Construct a new object Pool if ItemType is move constructible or the pool is backed by a storage policy
+     *
+     * @param numItems number of items in the pool
+     */
+    template<typename CTORItemType = ItemType, typename = typename std::enable_if<std::is_move_constructible<CTORItemType>::value || IsPoolStorage<StoragePolicy>::value>::type>
+    BasicPool(std::size_t  numItems): BasicPool(numItems, IsPoolStorage<StoragePolicy>{}) {
+    }
+
+    /**
+    * @brief Construct a new object Pool if ItemType is move constructible or the pool is backed by a storage policy
     *
     * @param numItems number of items in the pool
     * @param resetCb item state reset callback to be invoked immediately before the item is returned to the pool
     */
-    template<typename CTORItemType = ItemType, typename = typename std::enable_if<std::is_move_constructible<CTORItemType>::value>::type>
-    Pool(std::size_t  numItems, const CustomResetCallbackT& resetCb):Pool(numItems) {
-        this->customResetCallback = resetCb;
+    template<typename CTORItemType = ItemType, typename = typename std::enable_if<(std::is_move_constructible<CTORItemType>::value || IsPoolStorage<StoragePolicy>::value) &&
+             AcceptsResetCallback<ResetPolicy>::value>::type>
+    BasicPool(std::size_t  numItems, const CustomResetCallbackT& resetCb):BasicPool(numItems) {
+        this->resetPolicy = ResetPolicy(resetCb);
+    }
+
+    /**
+    * @brief Construct a new object Pool with a given instance of the reset policy, for policies holding state
+    *
+    * @param numItems number of items in the pool
+    * @param policy reset policy invoked for each item reset
+    */
+    template<typename CTORItemType = ItemType, typename = typename std::enable_if<std::is_move_constructible<CTORItemType>::value || IsPoolStorage<StoragePolicy>::value>::type>
+    BasicPool(std::size_t  numItems, const ResetPolicy& policy):BasicPool(numItems) {
+        this->resetPolicy = policy;
     }
 
+    /**
+     * @brief Construct a new object Pool backed by a storage policy, forwarding an extra argument to the storage.
+     * For LazyStorage, the argument is the ItemInitializer used to create each item on first use
+     *
+     * @param numItems number of items in the pool
+     * @param storageArg argument passed to the storage constructor, after the number of items
+     */
+    template<typename StorageArg, typename = typename std::enable_if<IsPoolStorage<StoragePolicy>::value &&
+             std::is_constructible<StoragePolicy, std::size_t, const StorageArg&>::value>::type>
+    BasicPool(std::size_t numItems, const StorageArg& storageArg): items(numItems, storageArg), indexer(numItems), occupancy(numItems), generations(numItems) {
+        this->ReserveResets();
+        this->RestoreIndexer();
+    }
 
     /**
-     * @brief Default static pool constructor
+     * @brief Construct a new object Pool backed by a storage policy, forwarding an extra argument to the storage,
+     * with a custom reset callback
+     *
+     * @param numItems number of items in the pool
+     * @param storageArg argument passed to the storage constructor, after the number of items
+     * @param resetCb item state reset callback to be invoked immediately before the item is returned to the pool
+     */
+    template<typename StorageArg, typename = typename std::enable_if<IsPoolStorage<StoragePolicy>::value &&
+             std::is_constructible<StoragePolicy, std::size_t, const StorageArg&>::value && AcceptsResetCallback<ResetPolicy>::value>::type>
+    BasicPool(std::size_t numItems, const StorageArg& storageArg, const CustomResetCallbackT& resetCb): BasicPool(numItems, storageArg) {
+        this->resetPolicy = ResetPolicy(resetCb);
+    }
+
+    /**
+     * @brief Construct a new object Pool resetting items in the background with tasks submitted to a worker pool,
+     * rather than with a thread owned by the pool. Only available with BackgroundReset
+     *
+     * @param numItems number of items in the pool
+     * @param resetWorkers worker pool running the reset tasks. It must outlive this pool
+     */
+    template<typename Mode = ResetMode, typename = typename std::enable_if<std::is_same<Mode, BackgroundReset>::value>::type>
+    BasicPool(std::size_t numItems, WorkerPool& resetWorkers): BasicPool(numItems) {
+        this->resetMode.RunOn(resetWorkers);
+    }
+
+    /**
+     * @brief Construct a new object Pool with a custom reset callback, resetting items in the background with tasks
+     * submitted to a worker pool. Only available with BackgroundReset
      *
+     * @param numItems number of items in the pool
+     * @param resetCb item state reset callback, invoked by the worker pool before the item is returned to the pool
+     * @param resetWorkers worker pool running the reset tasks. It must outlive this pool
      */
-    Pool(): indexer(FixedPoolSize) {
+    template<typename Mode = ResetMode, typename = typename std::enable_if<std::is_same<Mode, BackgroundReset>::value && AcceptsResetCallback<ResetPolicy>::value>::type>
+    BasicPool(std::size_t numItems, const CustomResetCallbackT& resetCb, WorkerPool& resetWorkers): BasicPool(numItems, resetCb) {
+        this->resetMode.RunOn(resetWorkers);
+    }
 
+    /**
+     * @brief Default static pool constructor
+     *
+     */
+    BasicPool(): indexer(FixedStorageSize<StoragePolicy>::value), occupancy(FixedStorageSize<StoragePolicy>::value),
+        generations(FixedStorageSize<StoragePolicy>::value) {
+        this->ReserveResets();
     }
 
     /**
@@ -99,8 +426,9 @@ class Pool final {
      *
      * @param resetCb item state reset callback to be invoked immediately before the item is returned to the pool
      */
-    Pool(const CustomResetCallbackT& resetCb): Pool() {
-        this->customResetCallback = resetCb;
+    template<typename Policy = ResetPolicy, typename = typename std::enable_if<AcceptsResetCallback<Policy>::value>::type>
+    BasicPool(const CustomResetCallbackT& resetCb): BasicPool() {
+        this->resetPolicy = ResetPolicy(resetCb);
     }
 
     /**
@@ -109,20 +437,263 @@ class Pool final {
      * @return PoolItem<ItemType> will be e mpty if there are no more items in the pool
      */
     inline auto Take() -> PoolItem<ItemType> {
+        return this->MakePoolItem(this->indexer.Next());
+    }
+
+    /**
+     * @brief Remove and return an element from the pool, blocking until an item is returned if the pool is empty.
+     * Only available when the pool's indexer supports waiting, e.g. WaitableIndexer
+     *
+     * @return PoolItem<ItemType> an item from the pool, never empty
+     */
+    template<typename WaitIndexer = IndexerPolicy, typename std::enable_if<IsWaitableIndexer<WaitIndexer>::value>::type* = nullptr>
+    inline auto TakeWait() -> PoolItem<ItemType> {
+        return this->MakePoolItem(this->indexer.NextWait());
+    }
+
+    /**
+     * @brief Remove and return an element from the pool, blocking up to timeout until an item is returned if the pool is empty.
+     * Only available when the pool's indexer supports waiting, e.g. WaitableIndexer
+     *
+     * @param timeout maximum time to wait for an item
+     * @return PoolItem<ItemType> will be empty if no item became available before the timeout
+     */
+    template<typename Rep, typename Period, typename WaitIndexer = IndexerPolicy, typename std::enable_if<IsWaitableIndexer<WaitIndexer>::value>::type* = nullptr>
+    inline auto TakeFor(const std::chrono::duration<Rep, Period>& timeout) -> PoolItem<ItemType> {
+        return this->MakePoolItem(this->indexer.NextFor(std::chrono::duration_cast<std::chrono::nanoseconds>(timeout)));
+    }
+
+    /**
+     * @brief Remove and return an element from the pool wrapped in a handle bound to this pool type.
+     *
+     * Handles avoid the type erased destroy callback used by PoolItem and are the preferred
+     * way to take items in hot paths.
+     *
+     * @return Handle will be empty if there are no more items in the pool
+     */
+    inline auto TakeHandle() -> Handle {
         auto holder = this->indexer.Next();
 
         if(holder.Empty()) {
+            this->RecordTake(0, 1);
             return {};
         }
 
-        auto returnToPoolFn = [this](const PoolItem<ItemType>& item) -> void{
-            this->InvokeReset(item.Get());
-            this->indexer.Return(item.PoolIndex());
-        };
+        this->AcquireIndex(holder.Get());
+        this->RecordTake(1, 1);
+        return Handle(this, holder.Get());
+    }
+
+    /**
+     * @brief Remove and return an element from the pool wrapped in a reference counted handle, for items
+     * handed to several consumers at once.
+     *
+     * Copies of the returned SharedItem share the item, which is reset and returned to the pool once the last copy is destroyed.
+     * Reference counts are kept by the pool, one per item, and allocated only once on the first call
+     * so copying a SharedItem never allocates.
+     *
+     * @return SharedItem will be empty if there are no more items in the pool
+     */
+    auto TakeShared() -> SharedItem {
+        std::call_once(this->referenceCountsInit, [this]() {
+            this->referenceCounts.reset(new std::atomic<std::uint32_t>[this->Size()]);
+        });
+
+        auto holder = this->indexer.Next();
+
+        if(holder.Empty()) {
+            this->RecordTake(0, 1);
+            return {};
+        }
 
         const auto index = holder.Get();
-        auto* item = &this->items.at(index);
-        return PoolItem<ItemType>(returnToPoolFn, item, index);
+        this->AcquireIndex(index);
+        this->RecordTake(1, 1);
+        this->referenceCounts[index].store(1, std::memory_order_relaxed);
+        return SharedItem(this, index);
+    }
+
+    /**
+     * @brief Remove up to count elements from the pool, appending a handle for each one to takenHandles.
+     *
+     * The indexer is accessed once for every MaxIndexBatchSize items rather than once per item.
+     *
+     * @param count maximum number of items to take
+     * @param takenHandles vector where the handles of the items taken are added to
+     * @return IndexSizeT number of items taken, which will be less than count if the pool runs out of items
+     */
+    auto TakeBatch(IndexSizeT count, std::vector<Handle>& takenHandles) -> IndexSizeT {
+        std::array<IndexSizeT, MaxIndexBatchSize> batchIndices{};
+        IndexSizeT totalTaken = 0;
+
+        takenHandles.reserve(takenHandles.size() + count);
+
+        while(totalTaken < count) {
+            const IndexSizeT requested = std::min(count - totalTaken, MaxIndexBatchSize);
+            const IndexSizeT taken = this->indexer.Next(requested, batchIndices.data());
+
+            for(IndexSizeT i = 0 ; i < taken ; i++) {
+                try {
+                    this->AcquireIndex(batchIndices[i]);
+                } catch(...) {
+                    // the failed index was given back already, the rest of the batch was never handed out
+                    this->indexer.Return(&batchIndices[i + 1], taken - i - 1);
+                    this->RecordTake(totalTaken + i, count);
+                    throw;
+                }
+
+                takenHandles.emplace_back(this, batchIndices[i]);
+            }
+
+            totalTaken += taken;
+            if(taken < requested) {
+                break;
+            }
+        }
+
+        this->RecordTake(totalTaken, count);
+        return totalTaken;
+    }
+
+    /**
+     * @brief Take the items that were in use when the pool's persistent storage, e.g. FileStorage, was last detached,
+     * appending a handle for each one to restoredHandles. Only available with persistent storages.
+     *
+     * Restored items are kept out of the pool until taken with this function, and are handed out as they were,
+     * without being reset. Subsequent calls take nothing.
+     *
+     * @param restoredHandles vector where the handles of the restored items are added to
+     * @return IndexSizeT number of items restored
+     */
+    template<typename Storage = StoragePolicy, typename std::enable_if<HasRestoredIndices<Storage>::value>::type* = nullptr>
+    auto TakeRestored(std::vector<Handle>& restoredHandles) -> IndexSizeT {
+        const auto& restored = this->items.RestoredIndices();
+        const auto count = restored.size();
+
+        restoredHandles.reserve(restoredHandles.size() + count);
+        for(const auto index: restored) {
+            this->occupancy.Set(index);
+            restoredHandles.emplace_back(this, index);
+        }
+
+        this->items.ClearRestored();
+        this->RecordTake(count, count);
+        return count;
+    }
+
+    /**
+     * @brief Return all items held by the handles in a batch, resetting each item and accessing the indexer
+     * once for every MaxIndexBatchSize items. All handles must have been taken from this pool.
+     *
+     * Once returned, the vector of handles is cleared.
+     *
+     * @param handles handles of the items to be returned. Empty handles are ignored
+     */
+    auto ReturnBatch(std::vector<Handle>& handles) -> void {
+        std::array<IndexSizeT, MaxIndexBatchSize> batchIndices{};
+        IndexSizeT batchSize = 0;
+
+        for(auto& handle: handles) {
+            if(handle.Empty()) {
+                continue;
+            }
+
+            batchIndices[batchSize] = handle.Release();
+            batchSize++;
+
+            if(batchSize == MaxIndexBatchSize) {
+                this->ReturnIndices(batchIndices.data(), batchSize);
+                batchSize = 0;
+            }
+        }
+
+        if(batchSize > 0) {
+            this->ReturnIndices(batchIndices.data(), batchSize);
+        }
+
+        handles.clear();
+    }
+
+    /**
+     * @brief Create a compact handle for an item currently taken from this pool, to be stored outside the pool,
+     * e.g. in timer wheels or hash maps, and later resolved with Resolve().
+     *
+     * The compact handle doesn't own the item and is invalidated as soon as the item is returned.
+     * Only available with SlotGenerations.
+     *
+     * @param poolIndex index of a taken item, as returned by PoolItem::PoolIndex, Handle::PoolIndex or SharedItem::PoolIndex
+     * @return CompactHandle handle packing the index and the current generation of the item's slot
+     */
+    template<typename Generations = GenerationPolicy, typename std::enable_if<Generations::Enabled>::type* = nullptr>
+    auto MakeCompactHandle(IndexSizeT poolIndex) -> CompactHandle {
+        // the generation policy rejects pools whose indices don't fit in 32 bits
+        return {static_cast<std::uint32_t>(poolIndex), this->generations.Current(poolIndex)};
+    }
+
+    /**
+     * @brief Resolve a compact handle to the item it refers to, if the item hasn't been returned since the handle was created.
+     * Only available with SlotGenerations.
+     *
+     * A stale handle, whose item was returned and possibly taken again, resolves to nullptr rather than to the new owner's item.
+     * The check is not a reservation: the caller must make sure the item isn't returned while the pointer is used,
+     * e.g. by resolving handles in the thread owning the items.
+     *
+     * @param handle handle created by MakeCompactHandle on this pool
+     * @return ItemType* the item, or nullptr if the handle is empty or stale
+     */
+    template<typename Generations = GenerationPolicy, typename std::enable_if<Generations::Enabled>::type* = nullptr>
+    auto Resolve(CompactHandle handle) -> ItemType* {
+        const auto index = handle.PoolIndex();
+
+        if(handle.Empty() || index >= this->Size() || this->generations.Current(index) != handle.Generation()) {
+            return nullptr;
+        }
+
+        return this->ItemAt(index);
+    }
+
+    /**
+     * @brief Invoke fn for every item currently taken, in index order, with the item's index and a pointer to the item.
+     * Only available with OccupancyBitmap.
+     *
+     * Only the words of the occupancy bitmap and the items in use are read, so periodic sweeps, e.g. for timeouts,
+     * cost little on large pools with few items taken. The scan doesn't stop other threads: items taken or returned
+     * while it runs may or may not be visited and fn must not use an item that its owner may return concurrently.
+     *
+     * @param fn callable invoked as fn(IndexSizeT poolIndex, ItemType* item)
+     */
+    template<typename Fn, typename Occupancy = OccupancyPolicy, typename std::enable_if<Occupancy::Enabled>::type* = nullptr>
+    auto ForEachInUse(Fn&& fn) -> void {
+        this->occupancy.ForEachSet([this, &fn](IndexSizeT index) {
+            fn(index, this->ItemAt(index));
+        });
+    }
+
+    /**
+     * @brief Invoke fn with the index of every item not currently taken, in index order. Only available with OccupancyBitmap.
+     *
+     * Free items are not passed to fn since they may not have been constructed yet, e.g. with LazyStorage.
+     * Items returned but still waiting for a BackgroundReset are free.
+     *
+     * @param fn callable invoked as fn(IndexSizeT poolIndex)
+     */
+    template<typename Fn, typename Occupancy = OccupancyPolicy, typename std::enable_if<Occupancy::Enabled>::type* = nullptr>
+    auto ForEachFree(Fn&& fn) const -> void {
+        this->occupancy.ForEachClear(std::forward<Fn>(fn));
+    }
+
+    /**
+     * @brief Block until all items returned so far have been reset and are available again.
+     * Only waits with BackgroundReset, where returned items are reset asynchronously
+     *
+     */
+    template<typename Mode = ResetMode, typename std::enable_if<std::is_same<Mode, BackgroundReset>::value>::type* = nullptr>
+    auto FlushResets() -> void {
+        this->resetMode.Flush();
+    }
+
+    template<typename Mode = ResetMode, typename std::enable_if<!std::is_same<Mode, BackgroundReset>::value>::type* = nullptr>
+    auto FlushResets() -> void {
     }
 
     /**
@@ -134,9 +705,63 @@ class Pool final {
         return this->items.size();
     }
 
-    FORBID_COPY_MOVE_ASSIGN(Pool);
-    virtual ~Pool() = default;
-}; // class Pool
+    /**
+     * @brief Returns the container holding the items of the pool, e.g. to inspect the memory mapping of a MappedStorage
+     *
+     * @return const StoragePolicy& the item container
+     */
+    auto Storage() const -> const StoragePolicy& {
+        return this->items;
+    }
+
+    /**
+     * @brief Returns a snapshot of the pool statistics, to be scraped by monitoring.
+     *
+     * Items taken, returned and in use, and failed takes, are counted by the pool when using ShardedStats.
+     * The high watermark, compare and swap retries, spins and lock contention are counted by the indexer,
+     * e.g. BasicMutexIndexer<ShardedStats> or BasicConcurrentIndexer<ShardedStats>. With NoStats in both, all values are zero.
+     *
+     * @return PoolStatsSnapshot counter values
+     */
+    auto Stats() const -> PoolStatsSnapshot {
+        auto snapshot = IndexerStatsOf(this->indexer);
+
+        if(StatsPolicy::Enabled) {
+            const auto poolSnapshot = this->stats.Snapshot();
+            snapshot.taken = poolSnapshot.taken;
+            snapshot.returned = poolSnapshot.returned;
+            snapshot.inUse = poolSnapshot.inUse;
+            snapshot.takeFailures = poolSnapshot.takeFailures;
+        }
+
+        return snapshot;
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(BasicPool);
+    virtual ~BasicPool() = default;
+}; // class BasicPool
+
+template<typename ItemType, typename ResetPolicy, typename StoragePolicy, typename IndexerPolicy, typename StatsPolicy, typename ResetMode,
+         typename OccupancyPolicy, typename GenerationPolicy>
+constexpr IndexSizeT BasicPool<ItemType, ResetPolicy, StoragePolicy, IndexerPolicy, StatsPolicy, ResetMode, OccupancyPolicy, GenerationPolicy>::MaxIndexBatchSize;
+
+/**
+ * @brief Alias for a pool with the default reset policy: items are reset with their Reset() member function if they have one,
+ * or with a custom reset callback given at construction otherwise
+ *
+ * @tparam ItemType type of the data to be stored
+ * @tparam ItemContainerType container or storage policy holding the items
+ * @tparam Indexer type of indexer to be used to when retrieving and returning objects.
+           The indexer defines the concurrency behaviour when using the pool in a multi-threaded context
+ * @tparam FixedPoolSize size of the pool, if specified as fixed. Kept for compatibility, the size of static pools is taken from std::array
+ * @tparam StatsPolicy statistics collected by the pool, NoStats or ShardedStats
+ * @tparam ResetMode when and by whom items are reset: ResetOnReturn, ResetOnTake or BackgroundReset
+ * @tparam OccupancyPolicy tracking of the items currently taken: NoOccupancy or OccupancyBitmap
+ * @tparam GenerationPolicy slot generations for compact handles: NoGenerations or SlotGenerations
+ */
+template<typename ItemType, typename ItemContainerType, typename Indexer = MutexIndexer, IndexSizeT FixedPoolSize = 0, typename StatsPolicy = NoStats,
+         typename ResetMode = ResetOnReturn, typename OccupancyPolicy = NoOccupancy, typename GenerationPolicy = NoGenerations>
+using Pool = BasicPool<ItemType, DefaultReset<ItemType>, ItemContainerType, Indexer, StatsPolicy, ResetMode, OccupancyPolicy, GenerationPolicy>;
 
 
 /**
@@ -160,6 +785,17 @@ using StaticPool= Pool<ItemType, std::array<ItemType, Size>, Indexer, Size>;
 template<typename ItemType, typename Indexer = MutexIndexer>
 using RuntimePool= Pool<ItemType, std::vector<ItemType>, Indexer>;
 
+/**
+ * @brief Alias for a pool backed by a LazyStorage, where each item is only constructed the first time it's taken.
+ * The size of the pool cannot be modified once created
+ *
+ * @tparam ItemType Type of the items in the pool. It doesn't need to be default constructible if an ItemInitializer is provided
+ * @tparam Indexer type of indexer to be used to when retrieving and returning objects.
+           The indexer defines the concurrency behaviour when using the pool in a multi-threaded context
+ */
+template<typename ItemType, typename Indexer = MutexIndexer>
+using LazyPool= Pool<ItemType, LazyStorage<ItemType>, Indexer>;
+
 
 } // namespace dxpool
 #endif
@@ -0,0 +1,322 @@
+#ifndef POOL_ALLOCATOR_H
+#define POOL_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define DXPOOL_HAS_MEMORY_RESOURCE 1
+#endif
+#endif
+
+#include "IndexHolder.h"
+#include "MutexIndexer.h"
+#include "TypePolicies.h"
+
+namespace dxpool {
+
+class InvalidBlockPoolArgumentsError: public std::invalid_argument {
+    using std::invalid_argument::invalid_argument;
+};
+
+/**
+ * @brief A fixed number of raw memory blocks of the same size, in a single contiguous buffer, handed out by an indexer.
+ *
+ * Taking a block takes an index from the indexer and returning it gives the index back, there are no per block objects.
+ * It's the storage behind PoolAllocator and PoolMemoryResource, which route requests that don't fit a block elsewhere.
+ *
+ * A block pool cannot be copied or moved and must outlive all blocks taken from it.
+ *
+ * @tparam IndexerPolicy type of indexer handing out block indices.
+ *         The indexer defines the concurrency behaviour when using the pool in a multi-threaded context
+ */
+template<typename IndexerPolicy = MutexIndexer>
+class BlockPool final {
+  private:
+    std::size_t blockAlignment;
+    std::size_t blockSize;
+    std::size_t numBlocks;
+    std::unique_ptr<unsigned char[]> buffer;
+    unsigned char* blocks{nullptr};
+    IndexerPolicy indexer;
+
+    static auto ValidAlignment(std::size_t alignment) -> std::size_t {
+        if(alignment == 0 || (alignment & (alignment - 1)) != 0) {
+            throw InvalidBlockPoolArgumentsError("Block alignment must be a power of two");
+        }
+
+        return alignment;
+    }
+
+    static auto ValidBlockSize(std::size_t size, std::size_t alignment) -> std::size_t {
+        if(size == 0) {
+            throw InvalidBlockPoolArgumentsError("Block size must be greater than zero");
+        }
+
+        // every block starts aligned
+        return (size + alignment - 1) & ~(alignment - 1);
+    }
+
+  public:
+    /**
+     * @brief Construct a new block pool
+     *
+     * @param blockCount number of blocks in the pool
+     * @param size size of each block in bytes, rounded up to a multiple of alignment
+     * @param alignment alignment of each block, a power of two
+     * @throws InvalidBlockPoolArgumentsError if size is zero or alignment is not a power of two
+     */
+    BlockPool(std::size_t blockCount, std::size_t size, std::size_t alignment = alignof(std::max_align_t)):
+        blockAlignment(ValidAlignment(alignment)), blockSize(ValidBlockSize(size, blockAlignment)), numBlocks(blockCount),
+        buffer(new unsigned char[(blockSize * blockCount) + blockAlignment - 1]), indexer(blockCount) {
+
+        const auto address = reinterpret_cast<std::uintptr_t>(this->buffer.get()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        const auto padding = ((address + this->blockAlignment - 1) & ~(this->blockAlignment - 1)) - address;
+        this->blocks = this->buffer.get() + padding; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    /**
+     * @brief Returns true if a request of bytes with alignment can be served by a block
+     *
+     */
+    inline auto Fits(std::size_t bytes, std::size_t alignment) const -> bool {
+        return bytes <= this->blockSize && alignment <= this->blockAlignment;
+    }
+
+    /**
+     * @brief Returns true if the pointer is in this pool's buffer, i.e. was returned by TakeBlock
+     *
+     */
+    inline auto Owns(const void* pointer) const -> bool {
+        // pointers from other allocations can't be compared with relational operators, their addresses can
+        const auto address = reinterpret_cast<std::uintptr_t>(pointer); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        const auto begin = reinterpret_cast<std::uintptr_t>(this->blocks); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        return address >= begin && address - begin < this->blockSize * this->numBlocks;
+    }
+
+    /**
+     * @brief Take a block from the pool
+     *
+     * @return void* start of the block, nullptr if all blocks are taken
+     */
+    inline auto TakeBlock() -> void* {
+        auto holder = this->indexer.Next();
+        if(holder.Empty()) {
+            return nullptr;
+        }
+
+        return this->blocks + (holder.Get() * this->blockSize); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    /**
+     * @brief Return a block to the pool. The block must have been taken from this pool
+     *
+     * @param block start of the block, as returned by TakeBlock
+     */
+    inline auto ReturnBlock(void* block) -> void {
+        const auto offset = static_cast<std::size_t>(static_cast<unsigned char*>(block) - this->blocks);
+        this->indexer.Return(offset / this->blockSize);
+    }
+
+    /**
+     * @brief Returns the size of each block in bytes, after rounding up to the alignment
+     *
+     */
+    auto BlockSize() const -> std::size_t {
+        return this->blockSize;
+    }
+
+    /**
+     * @brief Returns the number of blocks in the pool
+     *
+     */
+    auto Size() const -> std::size_t {
+        return this->numBlocks;
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(BlockPool);
+    ~BlockPool() = default;
+};
+
+/**
+ * @brief Allocator meeting the standard Allocator requirements that takes single objects from a BlockPool,
+ * for node based containers such as std::list, std::map or the nodes of std::unordered_map.
+ *
+ * Allocating one object that fits a block takes a block index from the pool and deallocating it returns the index.
+ * Requests for several objects or for objects larger than a block, such as the bucket array of std::unordered_map,
+ * are served by std::allocator. Allocation throws std::bad_alloc when all blocks are taken.
+ *
+ * Allocators rebound to other types share the same block pool and compare equal. The block pool must outlive
+ * every container using it, and its blocks must be large enough for the container's node type.
+ *
+ * @tparam T type of the objects allocated
+ * @tparam IndexerPolicy type of indexer of the block pool
+ */
+template<typename T, typename IndexerPolicy = MutexIndexer>
+class PoolAllocator {
+  private:
+    template<typename U, typename OtherIndexer>
+    friend class PoolAllocator;
+
+    BlockPool<IndexerPolicy>* blockPool;
+
+  public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    template<typename U>
+    struct rebind {
+        using other = PoolAllocator<U, IndexerPolicy>;
+    };
+
+    /**
+     * @brief Construct a new allocator taking blocks from a block pool
+     *
+     * @param blocks block pool, which must outlive the allocator and its copies
+     */
+    explicit PoolAllocator(BlockPool<IndexerPolicy>& blocks) noexcept : blockPool(&blocks) {
+    }
+
+    /**
+     * @brief Construct a new allocator sharing the block pool of an allocator of another type
+     *
+     */
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U, IndexerPolicy>& other) noexcept : blockPool(other.blockPool) { // NOLINT(google-explicit-constructor, hicpp-explicit-conversions)
+    }
+
+    /**
+     * @brief Allocate memory for count objects
+     *
+     * @param count number of objects
+     * @return T* uninitialized memory for the objects
+     * @throws std::bad_alloc if a block is required and all blocks are taken
+     */
+    auto allocate(std::size_t count) -> T* { // NOLINT(readability-identifier-naming)
+        if(count != 1 || !this->blockPool->Fits(sizeof(T), alignof(T))) {
+            return std::allocator<T>().allocate(count);
+        }
+
+        void* block = this->blockPool->TakeBlock();
+        if(block == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        return static_cast<T*>(block);
+    }
+
+    /**
+     * @brief Deallocate memory returned by allocate
+     *
+     * @param pointer memory returned by allocate
+     * @param count number of objects passed to allocate
+     */
+    auto deallocate(T* pointer, std::size_t count) noexcept -> void { // NOLINT(readability-identifier-naming)
+        if(this->blockPool->Owns(pointer)) {
+            this->blockPool->ReturnBlock(pointer);
+        } else {
+            std::allocator<T>().deallocate(pointer, count);
+        }
+    }
+
+    /**
+     * @brief Returns the block pool this allocator takes blocks from
+     *
+     */
+    auto Blocks() const -> BlockPool<IndexerPolicy>& {
+        return *this->blockPool;
+    }
+
+    template<typename U>
+    auto operator==(const PoolAllocator<U, IndexerPolicy>& other) const noexcept -> bool {
+        return this->blockPool == other.blockPool;
+    }
+
+    template<typename U>
+    auto operator!=(const PoolAllocator<U, IndexerPolicy>& other) const noexcept -> bool {
+        return this->blockPool != other.blockPool;
+    }
+};
+
+#ifdef DXPOOL_HAS_MEMORY_RESOURCE
+
+/**
+ * @brief std::pmr::memory_resource serving allocations that fit a block from a BlockPool it owns,
+ * for containers in std::pmr such as std::pmr::list or std::pmr::unordered_map.
+ *
+ * Allocations larger than a block or with a stricter alignment are forwarded to the upstream resource.
+ * Allocation throws std::bad_alloc when all blocks are taken. Only available with C++17 and <memory_resource>.
+ *
+ * @tparam IndexerPolicy type of indexer of the block pool
+ */
+template<typename IndexerPolicy = MutexIndexer>
+class PoolMemoryResource final: public std::pmr::memory_resource {
+  private:
+    BlockPool<IndexerPolicy> blockPool;
+    std::pmr::memory_resource* upstream;
+
+    auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override { // NOLINT(readability-identifier-naming)
+        if(!this->blockPool.Fits(bytes, alignment)) {
+            return this->upstream->allocate(bytes, alignment);
+        }
+
+        void* block = this->blockPool.TakeBlock();
+        if(block == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        return block;
+    }
+
+    auto do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) -> void override { // NOLINT(readability-identifier-naming)
+        if(this->blockPool.Owns(pointer)) {
+            this->blockPool.ReturnBlock(pointer);
+        } else {
+            this->upstream->deallocate(pointer, bytes, alignment);
+        }
+    }
+
+    auto do_is_equal(const std::pmr::memory_resource& other) const noexcept -> bool override { // NOLINT(readability-identifier-naming)
+        return this == &other;
+    }
+
+  public:
+    /**
+     * @brief Construct a new memory resource
+     *
+     * @param blockCount number of blocks
+     * @param blockSize size of each block in bytes
+     * @param blockAlignment alignment of each block, a power of two
+     * @param upstreamResource resource serving allocations that don't fit a block
+     * @throws InvalidBlockPoolArgumentsError if blockSize is zero or blockAlignment is not a power of two
+     */
+    PoolMemoryResource(std::size_t blockCount, std::size_t blockSize, std::size_t blockAlignment = alignof(std::max_align_t),
+                       std::pmr::memory_resource* upstreamResource = std::pmr::get_default_resource()):
+        blockPool(blockCount, blockSize, blockAlignment), upstream(upstreamResource) {
+    }
+
+    /**
+     * @brief Returns the block pool serving allocations
+     *
+     */
+    auto Blocks() -> BlockPool<IndexerPolicy>& {
+        return this->blockPool;
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(PoolMemoryResource);
+    ~PoolMemoryResource() override = default;
+};
+
+#endif // DXPOOL_HAS_MEMORY_RESOURCE
+
+} // namespace dxpool
+
+#endif // POOL_ALLOCATOR_H
@@ -0,0 +1,116 @@
+#ifndef POOL_HANDLE_H
+#define POOL_HANDLE_H
+
+#include <type_traits>
+
+#include "IndexHolder.h"
+#include "TypePolicies.h"
+
+namespace dxpool {
+
+/**
+ * @brief Lightweight handle to an item taken from a pool, statically bound to the type of the owning pool.
+ *
+ * Unlike PoolItem, a PoolHandle does not carry a type erased callback. It only holds a pointer to the pool
+ * and the index of the item, and returning the item to the pool is resolved at compile time and can be inlined.
+ *
+ * As with PoolItem, the item is returned to the pool when the handle is destroyed.
+ * Handles can be move constructed but not copied or assigned.
+ *
+ * @tparam PoolType type of the pool that owns the item
+ */
+template<typename PoolType>
+class PoolHandle final {
+  public:
+    /**
+     * @brief Type of the item held by this handle
+     *
+     */
+    using ItemType = typename PoolType::ValueType;
+
+  private:
+    friend PoolType;
+
+    PoolType* pool{nullptr};
+    IndexSizeT index{0};
+
+    /**
+     * @brief Detach the item from this handle without returning it to the pool.
+     * Used by the owning pool when returning items in batches
+     *
+     * @return IndexSizeT index of the item that was held
+     */
+    auto Release() -> IndexSizeT {
+        this->pool = nullptr;
+        return this->index;
+    }
+
+  public:
+    /**
+     * @brief The default constructor creates an empty handle
+     *
+     */
+    PoolHandle() = default;
+
+    /**
+     * @brief Construct a new handle for an item taken from a pool
+     *
+     * @param ownerPool pool the item was taken from and where it will be returned to
+     * @param poolIndex index of the item in the pool
+     */
+    PoolHandle(PoolType* ownerPool, IndexSizeT poolIndex) noexcept : pool(ownerPool), index(poolIndex) {
+    }
+
+    /**
+     * @brief Move constructor for a handle. After moved, the handle is considered empty
+     *
+     * @param movedHandle handle to be moved
+     */
+    PoolHandle(PoolHandle&& movedHandle) noexcept : pool(movedHandle.pool), index(movedHandle.index) {
+        movedHandle.pool = nullptr;
+    }
+
+    auto operator=(PoolHandle&&) -> PoolHandle& = delete;
+    PoolHandle(const PoolHandle&) = delete;
+    auto operator=(const PoolHandle&) -> PoolHandle& = delete;
+
+    /**
+     * @brief Returns true if there is no item held by this handle
+     *
+     */
+    auto Empty() const -> bool {
+        return this->pool == nullptr;
+    }
+
+    /**
+     * @brief Returns a pointer to the item held by this handle.
+     * If there is no item held (i.e, Empty() is true) the behaviour of this function is undefined
+     *
+     */
+    auto Get() const -> ItemType* {
+        return this->pool->ItemAt(this->index);
+    }
+
+    /**
+     * @brief Returns the index of the item in the pool. If there is no item held, the returned value is undefined
+     *
+     * @return IndexSizeT index position
+     */
+    auto PoolIndex() const -> IndexSizeT {
+        return this->index;
+    }
+
+    /**
+     * @brief Destruction returns the item to the pool, if there's one held
+     *
+     */
+    ~PoolHandle() {
+        if(this->pool != nullptr) {
+            this->pool->ReturnIndex(this->index);
+        }
+    }
+};
+
+} // namespace dxpool
+
+#endif // POOL_HANDLE_H
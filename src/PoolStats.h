@@ -0,0 +1,210 @@
+#ifndef POOL_STATS_H
+#define POOL_STATS_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "CacheLine.h"
+#include "Optimizers.h"
+#include "TypePolicies.h"
+
+namespace dxpool {
+
+/**
+ * @brief Counters collected by statistics policies
+ *
+ */
+enum class PoolStat : std::size_t {
+    Taken,          ///< items (or indices) successfully taken
+    Returned,       ///< items (or indices) returned
+    TakeFailures,   ///< take operations that got fewer items than requested, usually none
+    CASRetries,     ///< failed compare and swap attempts, each one followed by a retry
+    Spins,          ///< iterations spent yielding or busy waiting for another thread
+    LockContentions,///< lock acquisitions that found the lock already held
+    LockWaitNanos,  ///< time spent waiting for a held lock, in nanoseconds
+    Count
+};
+
+/**
+ * @brief Point in time view of the statistics of a pool or indexer.
+ *
+ * Counters are read without stopping other threads, so values taken at the same time may be slightly inconsistent
+ * with each other while the pool is in use.
+ */
+struct PoolStatsSnapshot {
+    std::uint64_t taken{0};
+    std::uint64_t returned{0};
+    std::uint64_t inUse{0};
+    std::uint64_t highWatermark{0};
+    std::uint64_t takeFailures{0};
+    std::uint64_t casRetries{0};
+    std::uint64_t spins{0};
+    std::uint64_t lockContentions{0};
+    std::uint64_t lockWaitNanos{0};
+};
+
+/**
+ * @brief Statistics policy that collects nothing. All operations are empty and optimized away
+ *
+ */
+class NoStats final {
+  public:
+    static constexpr bool Enabled = false;
+
+    NoStats() = default;
+
+    inline auto Add(PoolStat /* stat */, std::uint64_t /* value */) -> void {
+    }
+
+    inline auto ObserveInUse(std::uint64_t /* inUse */) -> void {
+    }
+
+    auto Snapshot() const -> PoolStatsSnapshot {
+        return {};
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(NoStats);
+    ~NoStats() = default;
+};
+
+/**
+ * @brief Statistics policy keeping its counters in per thread shards, so that updating them does not add contention.
+ *
+ * Each thread is assigned one of ShardCount shards, each on its own cache line, the first time it updates a counter.
+ * Threads only share a shard when there are more than ShardCount of them and even then counts remain exact.
+ * Snapshot adds up all shards.
+ *
+ * The high watermark is the only shared value but it's written only when a new maximum is observed.
+ */
+class ShardedStats final {
+  public:
+    static constexpr bool Enabled = true;
+
+    /**
+     * @brief Number of counter shards
+     *
+     */
+    static constexpr std::size_t ShardCount = 32;
+
+  private:
+    static constexpr std::size_t CounterCount = static_cast<std::size_t>(PoolStat::Count);
+
+    struct alignas(DefaultCacheLineSize) Shard {
+        std::array<std::atomic<std::uint64_t>, CounterCount> counters{};
+    };
+
+    std::array<Shard, ShardCount> shards{};
+    alignas(DefaultCacheLineSize) std::atomic<std::uint64_t> highWatermark{0};
+
+    static auto ThreadShard() -> std::size_t {
+        static std::atomic<std::size_t> nextShard{0};
+        // constant initialized so that accessing it doesn't go through the thread local initialization wrapper
+        thread_local std::size_t shard = ShardCount;
+
+        if(unlikely(shard == ShardCount)) {
+            shard = nextShard.fetch_add(1, std::memory_order_relaxed) % ShardCount;
+        }
+
+        return shard;
+    }
+
+    auto Total(PoolStat stat) const -> std::uint64_t {
+        std::uint64_t total = 0;
+        for(const auto& shard: this->shards) {
+            total += shard.counters[static_cast<std::size_t>(stat)].load(std::memory_order_relaxed);
+        }
+
+        return total;
+    }
+
+  public:
+    ShardedStats() {
+        for(auto& shard: this->shards) {
+            for(auto& counter: shard.counters) {
+                counter.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Add value to a counter in the shard of the calling thread
+     *
+     * @param stat counter to update
+     * @param value amount to be added
+     */
+    inline auto Add(PoolStat stat, std::uint64_t value) -> void {
+        this->shards[ThreadShard()].counters[static_cast<std::size_t>(stat)].fetch_add(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Record the number of items currently in use, raising the high watermark if it's a new maximum
+     *
+     * @param inUse number of items in use
+     */
+    inline auto ObserveInUse(std::uint64_t inUse) -> void {
+        auto current = this->highWatermark.load(std::memory_order_relaxed);
+        while(inUse > current) {
+            if(this->highWatermark.compare_exchange_weak(current, inUse, std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the current value of all counters.
+     * The number of items in use is calculated from the items taken and returned
+     *
+     * @return PoolStatsSnapshot counter values
+     */
+    auto Snapshot() const -> PoolStatsSnapshot {
+        PoolStatsSnapshot snapshot;
+        snapshot.taken = this->Total(PoolStat::Taken);
+        snapshot.returned = this->Total(PoolStat::Returned);
+        snapshot.inUse = snapshot.taken > snapshot.returned ? snapshot.taken - snapshot.returned : 0;
+        snapshot.highWatermark = this->highWatermark.load(std::memory_order_relaxed);
+        snapshot.takeFailures = this->Total(PoolStat::TakeFailures);
+        snapshot.casRetries = this->Total(PoolStat::CASRetries);
+        snapshot.spins = this->Total(PoolStat::Spins);
+        snapshot.lockContentions = this->Total(PoolStat::LockContentions);
+        snapshot.lockWaitNanos = this->Total(PoolStat::LockWaitNanos);
+
+        return snapshot;
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(ShardedStats);
+    ~ShardedStats() = default;
+};
+
+template <typename MaybeWithStats> auto HasIndexerStatsCondition(char) -> decltype(std::declval<const MaybeWithStats&>().Stats(), std::true_type {});
+template <typename MaybeWithStats> auto HasIndexerStatsCondition(...) -> std::false_type;
+
+/**
+ * @brief Determines if an indexer provides statistics through Stats()
+ *
+ */
+template <typename MaybeWithStats>
+using HasIndexerStats = decltype(HasIndexerStatsCondition<MaybeWithStats>(0));
+
+/**
+ * @brief Snapshot of the statistics of an indexer, or an empty snapshot if the indexer doesn't collect any
+ *
+ */
+template<typename Indexer, typename std::enable_if<HasIndexerStats<Indexer>::value>::type* = nullptr>
+auto IndexerStatsOf(const Indexer& indexer) -> PoolStatsSnapshot {
+    return indexer.Stats();
+}
+
+template<typename Indexer, typename std::enable_if<!HasIndexerStats<Indexer>::value>::type* = nullptr>
+auto IndexerStatsOf(const Indexer& /* indexer */) -> PoolStatsSnapshot {
+    return {};
+}
+
+} // namespace dxpool
+
+#endif // POOL_STATS_H
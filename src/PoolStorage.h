@@ -0,0 +1,266 @@
+#ifndef POOL_STORAGE_H
+#define POOL_STORAGE_H
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "IndexHolder.h"
+#include "TypePolicies.h"
+
+namespace dxpool {
+
+/**
+ * @brief Category tag that identifies a pool storage policy.
+ *
+ * Besides std::array and std::vector, a Pool can hold its items in a storage policy: a class that declares
+ * `using StorageCategory = PoolStorageTag` and provides
+ * - a constructor taking the number of items, and optionally other constructors taking the number of items and one extra argument
+ * - `operator[](IndexSizeT)` returning a reference to an item
+ * - `size()` returning the number of items
+ *
+ * A storage policy may also provide an `Acquire(IndexSizeT)` hook, invoked by the pool before an item is handed out,
+ * and a `Release(IndexSizeT)` hook, invoked once the item is reset and right before its index goes back to the indexer.
+ *
+ * Persistent storages can also provide `RestoredIndices()`, the indices of items that were in use when the storage
+ * was last detached, and `ClearRestored()`. The pool keeps those indices out of its indexer until taken with TakeRestored.
+ */
+struct PoolStorageTag {};
+
+template <typename MaybeStorage> auto IsPoolStorageCondition(char) -> decltype(std::declval<typename MaybeStorage::StorageCategory>(), std::true_type {});
+template <typename MaybeStorage> auto IsPoolStorageCondition(...) -> std::false_type;
+
+/**
+ * @brief Determines if a pool container type is a storage policy, as opposed to a standard container
+ *
+ */
+template <typename MaybeStorage>
+using IsPoolStorage = decltype(IsPoolStorageCondition<MaybeStorage>(0));
+
+/**
+ * @brief Number of items of a storage with a size fixed at compile time, such as std::array, zero for any other storage
+ *
+ */
+template <typename Storage>
+struct FixedStorageSize: std::integral_constant<IndexSizeT, 0> {};
+
+template <typename ItemType, std::size_t Size>
+struct FixedStorageSize<std::array<ItemType, Size>>: std::integral_constant<IndexSizeT, Size> {};
+
+template <typename Storage> auto HasAcquireHookCondition(char) -> decltype(std::declval<Storage&>().Acquire(IndexSizeT{}), std::true_type {});
+template <typename Storage> auto HasAcquireHookCondition(...) -> std::false_type;
+
+template <typename Storage> auto HasReleaseHookCondition(char) -> decltype(std::declval<Storage&>().Release(IndexSizeT{}), std::true_type {});
+template <typename Storage> auto HasReleaseHookCondition(...) -> std::false_type;
+
+template <typename Storage> auto HasRestoredIndicesCondition(char) -> decltype(std::declval<Storage&>().RestoredIndices(), std::true_type {});
+template <typename Storage> auto HasRestoredIndicesCondition(...) -> std::false_type;
+
+/**
+ * @brief Determines if a pool container is a persistent storage, restoring the items in use when it was last detached
+ *
+ */
+template <typename MaybeRestoring>
+using HasRestoredIndices = decltype(HasRestoredIndicesCondition<MaybeRestoring>(0));
+
+/**
+ * @brief Invokes the storage hooks of a pool container, if it has any
+ *
+ * @tparam Storage type of the pool container
+ */
+template<typename Storage>
+struct StorageHooks final {
+    template<typename HookedStorage = Storage, typename std::enable_if<decltype(HasAcquireHookCondition<HookedStorage>(0))::value>::type* = nullptr>
+    static inline auto Acquire(HookedStorage& storage, IndexSizeT index) -> void {
+        storage.Acquire(index);
+    }
+
+    template<typename HookedStorage = Storage, typename std::enable_if<!decltype(HasAcquireHookCondition<HookedStorage>(0))::value>::type* = nullptr>
+    static inline auto Acquire(HookedStorage& _storage, IndexSizeT _index) -> void {
+        (void)_storage;
+        (void)_index;
+    }
+
+    template<typename HookedStorage = Storage, typename std::enable_if<decltype(HasReleaseHookCondition<HookedStorage>(0))::value>::type* = nullptr>
+    static inline auto Release(HookedStorage& storage, IndexSizeT index) -> void {
+        storage.Release(index);
+    }
+
+    template<typename HookedStorage = Storage, typename std::enable_if<!decltype(HasReleaseHookCondition<HookedStorage>(0))::value>::type* = nullptr>
+    static inline auto Release(HookedStorage& _storage, IndexSizeT _index) -> void {
+        (void)_storage;
+        (void)_index;
+    }
+};
+
+/**
+ * @brief Constructs pool items in place, in uninitialized memory
+ *
+ * Use ConstructItemsWith or ConstructItemsWithFactory to create an initializer
+ *
+ * @tparam ItemType type of the items to be constructed
+ */
+template<typename ItemType>
+class ItemInitializer final {
+  public:
+    /**
+     * @brief Function constructing an item in the given memory address, for the given index in the pool
+     *
+     */
+    using ConstructFn = std::function<void(void*, IndexSizeT)>;
+
+  private:
+    ConstructFn constructFn;
+
+  public:
+    /**
+     * @brief Construct a new Item Initializer object
+     *
+     * @param constructItemFn function constructing (via placement new) an item in the memory provided
+     */
+    explicit ItemInitializer(ConstructFn constructItemFn): constructFn(std::move(constructItemFn)) {
+    }
+
+    /**
+     * @brief Construct an item in the memory provided
+     *
+     * @param memory uninitialized memory where the item will be created, with size and alignment for ItemType
+     * @param index index of the item in the pool
+     */
+    auto Construct(void* memory, IndexSizeT index) const -> void {
+        this->constructFn(memory, index);
+    }
+};
+
+/**
+ * @brief Creates an item initializer that constructs every item with the same constructor arguments.
+ * Arguments are copied into the initializer.
+ *
+ * @tparam ItemType type of the items to be constructed
+ * @tparam Args type of the constructor arguments
+ * @param args arguments passed to the constructor of each item
+ * @return ItemInitializer<ItemType> the initializer to be passed to the pool
+ */
+template<typename ItemType, typename... Args>
+auto ConstructItemsWith(Args... args) -> ItemInitializer<ItemType> {
+    return ItemInitializer<ItemType>([args...](void* memory, IndexSizeT _index) {
+        (void)_index;
+        new (memory) ItemType(args...);
+    });
+}
+
+/**
+ * @brief Creates an item initializer that constructs every item from the value returned by a factory.
+ * The factory receives the index of the item in the pool.
+ *
+ * Before C++17, ItemType must be move constructible to be initialized from the factory result.
+ *
+ * @tparam ItemType type of the items to be constructed
+ * @tparam Factory callable with signature ItemType(IndexSizeT)
+ * @param factory creates the value of each item
+ * @return ItemInitializer<ItemType> the initializer to be passed to the pool
+ */
+template<typename ItemType, typename Factory>
+auto ConstructItemsWithFactory(Factory factory) -> ItemInitializer<ItemType> {
+    return ItemInitializer<ItemType>([factory](void* memory, IndexSizeT index) {
+        new (memory) ItemType(factory(index));
+    });
+}
+
+/**
+ * @brief Pool storage that reserves uninitialized memory for all items but only constructs
+ * each item the first time its index is handed out by the pool.
+ *
+ * Memory for items that were never used is not touched, so large pools start quickly and
+ * only fault in the pages actually used. Items can be created via an ItemInitializer, which
+ * means ItemType does not need to be default constructible.
+ *
+ * ItemType alignment must not exceed the alignment guaranteed by operator new.
+ *
+ * @tparam ItemType type of the items stored
+ */
+template<typename ItemType>
+class LazyStorage final {
+  public:
+    using StorageCategory = PoolStorageTag;
+
+  private:
+    using SlotT = typename std::aligned_storage<sizeof(ItemType), alignof(ItemType)>::type;
+
+    static_assert(alignof(SlotT) == alignof(ItemType), "lazy storage slots must have the alignment of ItemType");
+
+    std::size_t numItems;
+    std::unique_ptr<SlotT[]> slots;
+    std::unique_ptr<bool[]> constructed;
+    ItemInitializer<ItemType> initializer;
+
+  public:
+    /**
+     * @brief Construct a new lazy storage for default constructible items
+     *
+     * @param storageSize number of items in the storage
+     */
+    LazyStorage(std::size_t storageSize): LazyStorage(storageSize, ConstructItemsWith<ItemType>()) {
+    }
+
+    /**
+     * @brief Construct a new lazy storage where items are created by an initializer
+     *
+     * @param storageSize number of items in the storage
+     * @param itemInitializer constructs each item the first time it's used
+     */
+    LazyStorage(std::size_t storageSize, const ItemInitializer<ItemType>& itemInitializer):
+        numItems(storageSize), slots(new SlotT[storageSize]), constructed(new bool[storageSize]()), initializer(itemInitializer) {
+    }
+
+    /**
+     * @brief Constructs the item at index if it hasn't been constructed yet.
+     * Invoked by the pool before handing out the index, which guarantees exclusive access to the item
+     *
+     * @param index index of the item
+     */
+    inline auto Acquire(IndexSizeT index) -> void {
+        if(!this->constructed[index]) {
+            this->initializer.Construct(&this->slots[index], index);
+            this->constructed[index] = true;
+        }
+    }
+
+    /**
+     * @brief Returns the item at index. The item must have been acquired at least once
+     *
+     * @param index index of the item
+     * @return ItemType& reference to the item
+     */
+    inline auto operator[](IndexSizeT index) -> ItemType& {
+        return *reinterpret_cast<ItemType*>(&this->slots[index]); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+
+    /**
+     * @brief Returns the number of items the storage can hold
+     *
+     * @return std::size_t number of items
+     */
+    auto size() const -> std::size_t { // NOLINT(readability-identifier-naming)
+        return this->numItems;
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(LazyStorage);
+
+    ~LazyStorage() {
+        for(std::size_t i = 0 ; i < this->numItems ; i++) {
+            if(this->constructed[i]) {
+                (*this)[i].~ItemType();
+            }
+        }
+    }
+};
+
+} // namespace dxpool
+
+#endif // POOL_STORAGE_H
@@ -0,0 +1,225 @@
+#ifndef RESET_MODES_H
+#define RESET_MODES_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "IndexHolder.h"
+#include "TypePolicies.h"
+#include "WorkerPool.h"
+
+namespace dxpool {
+
+/**
+ * @brief Reset mode where items are reset by the thread returning them, before their index goes back to the indexer.
+ * This is the default mode
+ *
+ */
+class ResetOnReturn final {
+  public:
+    template<typename ResetTask>
+    explicit ResetOnReturn(const ResetTask& /* resetTask */) {
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(ResetOnReturn);
+    ~ResetOnReturn() = default;
+};
+
+/**
+ * @brief Reset mode where items are returned as they are and reset by the thread taking them, right before
+ * they are handed out. Every item is reset when taken, including the first time.
+ *
+ * Suits workloads where items are often returned without being used much, or where the cost of cleaning
+ * is better paid by the consumer than by the producer
+ *
+ */
+class ResetOnTake final {
+  public:
+    template<typename ResetTask>
+    explicit ResetOnTake(const ResetTask& /* resetTask */) {
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(ResetOnTake);
+    ~ResetOnTake() = default;
+};
+
+/**
+ * @brief Reset mode where the indices of returned items are queued and a background worker resets the items,
+ * only giving the indices back to the indexer once the items are clean.
+ *
+ * Returning an item only adds its index to a queue with space for every item in the pool, so it never allocates.
+ * Items are reset and returned to the indexer in batches, either by a thread owned by the pool, started on the first return,
+ * or by tasks submitted to a WorkerPool. A worker pool must outlive the pools using it.
+ *
+ * Returned items are not available to be taken again until the worker has reset them.
+ */
+class BackgroundReset final {
+  public:
+    /**
+     * @brief Type of the task resetting a batch of items and returning their indices to the indexer
+     *
+     */
+    using ResetTask = std::function<void(const IndexSizeT*, IndexSizeT)>;
+
+  private:
+    ResetTask resetTask;
+    WorkerPool* workerPool{nullptr};
+
+    std::mutex mutex;
+    std::condition_variable workCondVar;
+    std::condition_variable idleCondVar;
+    std::vector<IndexSizeT> pending;
+    std::vector<IndexSizeT> resetting;
+    bool scheduled{false};
+    bool stopping{false};
+    std::thread worker;
+
+    /**
+     * @brief Reset all pending items until there are none left. Only one thread drains at a time
+     *
+     */
+    auto Drain() -> void {
+        while(true) {
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                if(this->pending.empty()) {
+                    this->scheduled = false;
+                    this->idleCondVar.notify_all();
+                    return;
+                }
+
+                // resetting keeps its capacity, so swapping never allocates
+                this->resetting.swap(this->pending);
+            }
+
+            this->resetTask(this->resetting.data(), this->resetting.size());
+            this->resetting.clear();
+        }
+    }
+
+    auto RunWorker() -> void {
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        while(true) {
+            this->workCondVar.wait(lock, [this] { return this->scheduled || this->stopping; });
+            if(!this->scheduled) {
+                return;
+            }
+
+            lock.unlock();
+            this->Drain();
+            lock.lock();
+        }
+    }
+
+    /**
+     * @brief Make sure a drain is scheduled, must be called while holding the lock
+     *
+     */
+    auto Schedule() -> void {
+        if(this->scheduled) {
+            return;
+        }
+
+        this->scheduled = true;
+
+        if(this->workerPool != nullptr) {
+            this->workerPool->Submit([this] { this->Drain(); });
+        } else if(!this->worker.joinable()) {
+            this->worker = std::thread([this] { this->RunWorker(); });
+        } else {
+            this->workCondVar.notify_one();
+        }
+    }
+
+  public:
+    /**
+     * @brief Construct a new background reset mode
+     *
+     * @param task task resetting a batch of items and returning their indices to the indexer
+     */
+    explicit BackgroundReset(ResetTask task): resetTask(std::move(task)) {
+    }
+
+    /**
+     * @brief Reserve space for the indices of all items in the pool, so returning items never allocates
+     *
+     * @param poolSize number of items in the pool
+     */
+    auto Reserve(std::size_t poolSize) -> void {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->pending.reserve(poolSize);
+        this->resetting.reserve(poolSize);
+    }
+
+    /**
+     * @brief Reset items using tasks submitted to a worker pool instead of a thread owned by the pool.
+     * Must be called before any item is returned
+     *
+     * @param workers worker pool running the reset tasks. It must outlive the pool
+     */
+    auto RunOn(WorkerPool& workers) -> void {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->workerPool = &workers;
+    }
+
+    /**
+     * @brief Queue the index of a returned item to be reset
+     *
+     * @param index index of the item
+     */
+    auto Submit(IndexSizeT index) -> void {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->pending.push_back(index);
+        this->Schedule();
+    }
+
+    /**
+     * @brief Queue the indices of a batch of returned items to be reset
+     *
+     * @param indices indices of the items
+     * @param count number of indices
+     */
+    auto Submit(const IndexSizeT* indices, IndexSizeT count) -> void {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->pending.insert(this->pending.end(), indices, indices + count); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        this->Schedule();
+    }
+
+    /**
+     * @brief Block until all items returned so far have been reset and returned to the indexer
+     *
+     */
+    auto Flush() -> void {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->idleCondVar.wait(lock, [this] { return !this->scheduled; });
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(BackgroundReset);
+
+    /**
+     * @brief Destruction waits for all pending resets and stops the worker thread, if any
+     *
+     */
+    ~BackgroundReset() {
+        this->Flush();
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->stopping = true;
+            this->workCondVar.notify_one();
+        }
+
+        if(this->worker.joinable()) {
+            this->worker.join();
+        }
+    }
+};
+
+} // namespace dxpool
+
+#endif // RESET_MODES_H
@@ -0,0 +1,85 @@
+#ifndef RESET_POLICIES_H
+#define RESET_POLICIES_H
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace dxpool {
+
+template <typename MaybeResetable> auto IsResetableTypeCondition(char) -> decltype(std::declval<MaybeResetable>().Reset(), std::true_type {});
+template <typename MaybeResetable> auto IsResetableTypeCondition(...) -> std::false_type;
+
+template <typename MaybeResetable>
+using IsResetableType = decltype(IsResetableTypeCondition<MaybeResetable>(0));
+
+/**
+ * @brief Reset policy invoking the item's own Reset() member function
+ *
+ */
+class MemberReset final {
+  public:
+    template<typename ItemType>
+    inline auto operator()(ItemType* item) const -> void {
+        item->Reset();
+    }
+};
+
+/**
+ * @brief Reset policy leaving items as they are. Resetting is elided entirely.
+ * It also accepts the fields of SoAPool items
+ *
+ */
+class NoReset final {
+  public:
+    template<typename... ItemTypes>
+    inline auto operator()(ItemTypes*... /* items */) const -> void {
+    }
+};
+
+/**
+ * @brief Reset policy invoking a callback given at runtime, through a std::function.
+ * Items are left as they are if no callback is given
+ *
+ * @tparam ItemType type of the items being reset
+ */
+template<typename ItemType>
+class CallbackReset final {
+  public:
+    /**
+     * @brief Type of the callback resetting an item
+     *
+     */
+    using CallbackT = std::function<void(ItemType*)>;
+
+  private:
+    CallbackT callback = [](ItemType*) {};
+
+  public:
+    CallbackReset() = default;
+
+    /**
+     * @brief Construct a new callback reset policy
+     *
+     * @param resetCb item state reset callback
+     */
+    CallbackReset(CallbackT resetCb): callback(std::move(resetCb)) {
+    }
+
+    inline auto operator()(ItemType* item) const -> void {
+        this->callback(item);
+    }
+};
+
+/**
+ * @brief Reset policy used by Pool and its aliases: MemberReset if ItemType has a Reset() member function,
+ * CallbackReset otherwise
+ *
+ * @tparam ItemType type of the items being reset
+ */
+template<typename ItemType>
+using DefaultReset = typename std::conditional<IsResetableType<ItemType>::value, MemberReset, CallbackReset<ItemType>>::type;
+
+} // namespace dxpool
+
+#endif // RESET_POLICIES_H
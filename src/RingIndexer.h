@@ -0,0 +1,237 @@
+#ifndef RING_INDEXER_H
+#define RING_INDEXER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+#include "ConcurrentIndexer.h"
+#include "IndexHolder.h"
+#include "PoolStats.h"
+#include "TypePolicies.h"
+
+namespace dxpool {
+
+class InvalidRingIndexerArgumentsError: public std::invalid_argument {
+    using std::invalid_argument::invalid_argument;
+};
+
+/**
+ * @brief Lock-free FIFO indexer, a ring of poolSize slots where each slot is claimed directly with a compare and swap.
+ *
+ * Every slot is a single 64 bit word packing the index it holds, whether it's full, and the lap (cycle) of the ring
+ * it belongs to. Taking an index swaps the slot at the read position from full to empty for the next lap, and returning
+ * an index swaps the slot at the write position from empty to full. The read and write positions are only advanced
+ * afterwards, and any thread finding a slot already swapped for its position advances the position on behalf of
+ * the thread that swapped it.
+ *
+ * Since a slot is taken or filled in one atomic operation, there are no half written slots, and no thread ever waits
+ * for another thread to finish its operation: an empty slot at the read position means there are no more indices.
+ * This is unlike ConcurrentIndexer, where threads reserve a position first and yield while the slot is being written,
+ * which can stall for a whole time slice when there are more threads than cores.
+ *
+ * Memory use is one 64 bit word per index. Indices must fit in 32 bits.
+ *
+ * @tparam StatsPolicy statistics collected by the indexer, NoStats or ShardedStats. With ShardedStats the indexer
+ *         also counts compare and swap retries, including position updates made on behalf of other threads
+ */
+template<typename StatsPolicy = NoStats>
+class BasicRingIndexer final {
+  private:
+    static constexpr const unsigned CycleShift = 33;
+    static constexpr const std::uint64_t FullFlag = std::uint64_t{1} << 32;
+    static constexpr const std::uint64_t CycleMask = (std::uint64_t{1} << (64 - CycleShift)) - 1;
+
+    alignas(AtomicAlignment) std::atomic<std::uint64_t> readPos{0};
+    alignas(AtomicAlignment) std::atomic<std::uint64_t> writePos{0};
+
+    const std::uint64_t size;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> slots;
+
+    StatsPolicy stats;
+
+    inline auto Cycle(std::uint64_t position) const -> std::uint64_t {
+        return (position / this->size) & CycleMask;
+    }
+
+    static inline auto FullSlot(std::uint64_t cycle, IndexSizeT index) -> std::uint64_t {
+        return (cycle << CycleShift) | FullFlag | index;
+    }
+
+    static inline auto EmptySlot(std::uint64_t cycle) -> std::uint64_t {
+        return cycle << CycleShift;
+    }
+
+    static inline auto SlotCycle(std::uint64_t slot) -> std::uint64_t {
+        return slot >> CycleShift;
+    }
+
+    static inline auto SlotIndex(std::uint64_t slot) -> IndexSizeT {
+        return static_cast<std::uint32_t>(slot);
+    }
+
+    /**
+     * @brief Move a position past a slot already swapped, unless another thread did it first
+     *
+     */
+    inline auto Advance(std::atomic<std::uint64_t>& position, std::uint64_t current) -> void {
+        position.compare_exchange_strong(current, current + 1, std::memory_order_release, std::memory_order_relaxed);
+    }
+
+    inline auto RecordTaken() -> void {
+        if(!StatsPolicy::Enabled) {
+            return;
+        }
+
+        this->stats.Add(PoolStat::Taken, 1);
+
+        // both positions may lag behind the slots, so this is an estimate that's exact when there's no concurrent access
+        const std::uint64_t curReadPos = this->readPos.load(std::memory_order_relaxed);
+        const std::uint64_t curWritePos = this->writePos.load(std::memory_order_relaxed);
+        const std::uint64_t available = curWritePos > curReadPos ? curWritePos - curReadPos : 0;
+        this->stats.ObserveInUse(this->size - std::min(available, this->size));
+    }
+
+  public:
+    /**
+     * @brief Construct a new Ring Indexer with all indices from 0 to poolSize - 1 in the ring
+     *
+     * @param poolSize number of possible indices
+     * @throws InvalidRingIndexerArgumentsError if poolSize indices don't fit in 32 bits
+     */
+    BasicRingIndexer(IndexSizeT poolSize): writePos(poolSize), size(poolSize) {
+        if(poolSize > std::numeric_limits<std::uint32_t>::max()) {
+            throw InvalidRingIndexerArgumentsError("Ring indexer size must be smaller than 2^32");
+        }
+
+        this->slots.reset(new std::atomic<std::uint64_t>[poolSize]);
+
+        // all slots are filled during the first lap, ready to be taken
+        for(IndexSizeT i = 0 ; i < poolSize ; i++) {
+            this->slots[i].store(FullSlot(0, i), std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Get the next available index, in the order indices were returned
+     * if there are no more indices, the returning IndexHolder will be empty
+     *
+     * @return IndexHolder next available index
+     */
+    auto Next() -> IndexHolder {
+        if(unlikely(this->size == 0)) {
+            return {};
+        }
+
+        while(true) {
+            const std::uint64_t curReadPos = this->readPos.load(std::memory_order_acquire);
+            const std::uint64_t cycle = this->Cycle(curReadPos);
+            std::atomic<std::uint64_t>& slot = this->slots[curReadPos % this->size];
+            std::uint64_t slotValue = slot.load(std::memory_order_acquire);
+
+            if(slotValue == EmptySlot(cycle)) {
+                // nothing has been returned to this position yet
+                this->stats.Add(PoolStat::TakeFailures, 1);
+                return {};
+            }
+
+            if((slotValue & FullFlag) != 0 && SlotCycle(slotValue) == cycle) {
+                if(slot.compare_exchange_strong(slotValue, EmptySlot((cycle + 1) & CycleMask), std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                    this->Advance(this->readPos, curReadPos);
+                    this->RecordTaken();
+                    return {SlotIndex(slotValue)};
+                }
+            } else {
+                // the slot was already taken at this position, the read position is behind
+                this->Advance(this->readPos, curReadPos);
+            }
+
+            this->stats.Add(PoolStat::CASRetries, 1);
+        }
+    }
+
+    /**
+     * @brief Return an index to the pool.
+     * There are no checks for validity of the index so callers must ensure the index is within the range of the pool
+     * and that they have not been previously returned.
+     * Returning more indices than the pool size will result in undefined behavior.
+     */
+    auto Return(IndexSizeT index) -> void {
+        while(true) {
+            const std::uint64_t curWritePos = this->writePos.load(std::memory_order_acquire);
+            const std::uint64_t cycle = this->Cycle(curWritePos);
+            std::atomic<std::uint64_t>& slot = this->slots[curWritePos % this->size];
+            std::uint64_t slotValue = EmptySlot(cycle);
+
+            if(slot.compare_exchange_strong(slotValue, FullSlot(cycle, index), std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                this->Advance(this->writePos, curWritePos);
+                this->stats.Add(PoolStat::Returned, 1);
+                return;
+            }
+
+            // the slot was already filled at this position, the write position is behind.
+            // It can't hold an index of the previous lap, as the ring would hold more indices than the pool size
+            this->Advance(this->writePos, curWritePos);
+            this->stats.Add(PoolStat::CASRetries, 1);
+        }
+    }
+
+    /**
+     * @brief Get up to count available indices.
+     * Each index is taken with its own compare and swap, as slots are claimed individually
+     *
+     * @param count maximum number of indices to retrieve
+     * @param outIndices destination of the retrieved indices. It must have space for at least count indices
+     * @return IndexSizeT number of indices written to outIndices. Zero if there are no more indices
+     */
+    auto Next(IndexSizeT count, IndexSizeT* outIndices) -> IndexSizeT {
+        IndexSizeT taken = 0;
+        for(; taken < count ; taken++) {
+            const IndexHolder result = this->Next();
+            if(result.Empty()) {
+                break;
+            }
+
+            outIndices[taken] = result.Get(); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        return taken;
+    }
+
+    /**
+     * @brief Return a batch of indices, in order.
+     * The same restrictions of Return(IndexSizeT) apply to every index in the batch.
+     *
+     * @param returnedIndices indices to be returned
+     * @param count number of indices in returnedIndices
+     */
+    auto Return(const IndexSizeT* returnedIndices, IndexSizeT count) -> void {
+        for(IndexSizeT i = 0 ; i < count ; i++) {
+            this->Return(returnedIndices[i]); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+    }
+
+    /**
+     * @brief Returns the statistics collected by the indexer. Empty when using NoStats
+     *
+     * @return PoolStatsSnapshot counter values
+     */
+    auto Stats() const -> PoolStatsSnapshot {
+        return this->stats.Snapshot();
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(BasicRingIndexer);
+    ~BasicRingIndexer() = default;
+};
+
+/**
+ * @brief Slot ring indexer without statistics
+ *
+ */
+using RingIndexer = BasicRingIndexer<NoStats>;
+
+} // namespace dxpool
+#endif
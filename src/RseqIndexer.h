@@ -0,0 +1,415 @@
+#ifndef RSEQ_INDEXER_H
+#define RSEQ_INDEXER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#if defined(__linux__) && defined(__x86_64__) && defined(__has_include)
+#if __has_include(<sys/rseq.h>) && __has_include(<linux/membarrier.h>)
+#include <linux/membarrier.h>
+#include <sys/rseq.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#ifdef RSEQ_SIG
+#define DXPOOL_HAS_RSEQ 1
+#endif
+#endif
+#endif
+
+#include "AlignedMemory.h"
+#include "ConcurrentIndexer.h"
+#include "IndexHolder.h"
+#include "Optimizers.h"
+#include "TypePolicies.h"
+
+namespace dxpool {
+
+/**
+ * @brief Default number of indices cached per CPU by a RseqIndexer
+ *
+ */
+const constexpr IndexSizeT DefaultCpuCacheCapacity = 64;
+
+/**
+ * @brief Indexer that keeps a cache of free indices per CPU in front of a shared indexer, updated with Linux restartable
+ * sequences (rseq).
+ *
+ * Taking and returning an index pops or pushes it on the cache of the CPU the thread is running on, in a short
+ * critical section the kernel restarts if the thread is preempted, migrated or signalled before the commit.
+ * The fast path has no atomic instruction and no lock, and unlike a per thread cache, it doesn't depend on the number
+ * of threads or on threads staying on the same CPU.
+ *
+ * An empty CPU cache is refilled with half its capacity from the shared indexer, and indices returned to a full cache go
+ * to the shared indexer. When the shared indexer runs out, the indices cached by every CPU are moved back to it:
+ * the CPU cache is locked, and membarrier restarts any critical section running on that CPU, so that it sees the lock.
+ *
+ * rseq must be registered by the C library (glibc 2.35 or later) and membarrier must support rseq (Linux 5.10 or later),
+ * which is checked once at runtime. Otherwise, or on architectures other than x86-64, all operations go straight to the
+ * shared indexer.
+ *
+ * @tparam Indexer shared indexer holding the indices not cached by any CPU. It must support batch operations
+ * @tparam CacheCapacity maximum number of indices cached per CPU
+ */
+template<typename Indexer = ConcurrentIndexer, IndexSizeT CacheCapacity = DefaultCpuCacheCapacity>
+class RseqIndexer final {
+    static_assert(CacheCapacity >= 2, "CacheCapacity must be at least 2");
+
+  private:
+    static constexpr IndexSizeT RefillSize = CacheCapacity / 2;
+
+    struct alignas(AtomicAlignment) CpuCache {
+        IndexSizeT count{0};
+        // non zero while the cache is being drained by another CPU. Critical sections abort when set
+        std::uint32_t locked{0};
+        std::array<IndexSizeT, CacheCapacity> indices{};
+    };
+
+    enum class SequenceResult {
+        Committed,
+        Unavailable,    ///< cache empty on take or full on return
+        Aborted         ///< the thread moved to another CPU, was preempted or the cache is locked
+    };
+
+    Indexer shared;
+    std::size_t cacheCount{0};
+    // caches are aligned to cache lines, over the alignment guaranteed by new before C++17
+    AlignedArray<CpuCache> caches;
+
+#ifdef DXPOOL_HAS_RSEQ
+#define DXPOOL_RSEQ_STRINGIFY_VALUE(value) #value
+#define DXPOOL_RSEQ_STRINGIFY(value) DXPOOL_RSEQ_STRINGIFY_VALUE(value)
+
+// Critical section descriptor (label 3), registered in the thread's rseq area before the sequence starts (label 1).
+// The sequence must end with a single commit store (label 2), and aborts jump to label 4, preceded by the signature
+#define DXPOOL_RSEQ_BEGIN \
+    ".pushsection __rseq_cs, \"aw\"\n\t" \
+    ".balign 32\n\t" \
+    "3:\n\t" \
+    ".long 0x0, 0x0\n\t" \
+    ".quad 1f, (2f - 1f), 4f\n\t" \
+    ".popsection\n\t" \
+    "leaq 3b(%%rip), %%rax\n\t" \
+    "movq %%rax, %[rseqCs]\n\t" \
+    "1:\n\t" \
+    "cmpl %[cpu], %[currentCpu]\n\t" \
+    "jnz 4f\n\t" \
+    "cmpl $0, %[locked]\n\t" \
+    "jnz 4f\n\t"
+
+#define DXPOOL_RSEQ_END \
+    "2:\n\t" \
+    ".pushsection __rseq_failure, \"ax\"\n\t" \
+    ".byte 0x0f, 0xb9, 0x3d\n\t" \
+    ".long " DXPOOL_RSEQ_STRINGIFY(RSEQ_SIG) "\n\t" \
+    "4:\n\t" \
+    "jmp %l[aborted]\n\t" \
+    ".popsection\n\t"
+
+    static inline auto RseqArea() -> struct rseq* {
+        return reinterpret_cast<struct rseq*>(static_cast<char*>(__builtin_thread_pointer()) + __rseq_offset); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    /**
+     * @brief Checks once per process if the C library registered rseq for its threads and registers the process
+     * for membarrier restarting rseq critical sections
+     *
+     */
+    static auto RseqAvailable() -> bool {
+        static const bool available = []() -> bool {
+            if(__rseq_size == 0 || static_cast<std::int32_t>(__atomic_load_n(&RseqArea()->cpu_id, __ATOMIC_RELAXED)) < 0) {
+                return false;
+            }
+
+            return syscall(__NR_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED_RSEQ, 0, 0) == 0; // NOLINT(cppcoreguidelines-pro-type-vararg, hicpp-vararg)
+        }();
+
+        return available;
+    }
+
+    /**
+     * @brief Returns the cache of the CPU the thread is running on, or nullptr if there's none
+     *
+     */
+    inline auto CurrentCache(std::uint32_t& cpu) const -> CpuCache* {
+        if(this->caches == nullptr) {
+            return nullptr;
+        }
+
+        cpu = __atomic_load_n(&RseqArea()->cpu_id, __ATOMIC_RELAXED);
+        return cpu < this->cacheCount ? &this->caches[cpu] : nullptr;
+    }
+
+    static inline auto TryPop(CpuCache& cache, std::uint32_t cpu, IndexSizeT& index) -> SequenceResult {
+        struct rseq* area = RseqArea();
+        __asm__ __volatile__ goto(
+            DXPOOL_RSEQ_BEGIN
+            "movq %[count], %%rcx\n\t"
+            "testq %%rcx, %%rcx\n\t"
+            "jz %l[empty]\n\t"
+            "movq -8(%[indices], %%rcx, 8), %%rdx\n\t"
+            "movq %%rdx, %[index]\n\t"
+            "decq %%rcx\n\t"
+            "movq %%rcx, %[count]\n\t"
+            DXPOOL_RSEQ_END
+            : /* asm goto can't have outputs before GCC 11, index is written through a memory operand */
+            : [cpu] "r"(cpu), [currentCpu] "m"(area->cpu_id), [rseqCs] "m"(area->rseq_cs), [locked] "m"(cache.locked),
+              [count] "m"(cache.count), [indices] "r"(cache.indices.data()), [index] "m"(index)
+            : "memory", "cc", "rax", "rcx", "rdx"
+            : empty, aborted);
+        return SequenceResult::Committed;
+      empty:
+        return SequenceResult::Unavailable;
+      aborted:
+        return SequenceResult::Aborted;
+    }
+
+    static inline auto TryPush(CpuCache& cache, std::uint32_t cpu, IndexSizeT index) -> SequenceResult {
+        struct rseq* area = RseqArea();
+        __asm__ __volatile__ goto(
+            DXPOOL_RSEQ_BEGIN
+            "movq %[count], %%rcx\n\t"
+            "cmpq %[capacity], %%rcx\n\t"
+            "jae %l[full]\n\t"
+            "movq %[index], (%[indices], %%rcx, 8)\n\t"
+            "incq %%rcx\n\t"
+            "movq %%rcx, %[count]\n\t"
+            DXPOOL_RSEQ_END
+            :
+            : [cpu] "r"(cpu), [currentCpu] "m"(area->cpu_id), [rseqCs] "m"(area->rseq_cs), [locked] "m"(cache.locked),
+              [count] "m"(cache.count), [indices] "r"(cache.indices.data()), [index] "r"(index), [capacity] "i"(CacheCapacity)
+            : "memory", "cc", "rax", "rcx"
+            : full, aborted);
+        return SequenceResult::Committed;
+      full:
+        return SequenceResult::Unavailable;
+      aborted:
+        return SequenceResult::Aborted;
+    }
+
+#undef DXPOOL_RSEQ_BEGIN
+#undef DXPOOL_RSEQ_END
+#undef DXPOOL_RSEQ_STRINGIFY
+#undef DXPOOL_RSEQ_STRINGIFY_VALUE
+
+    /**
+     * @brief Makes sure no critical section on cpu still sees the cache unlocked
+     *
+     */
+    static auto RestartCriticalSections(std::uint32_t cpu) -> void {
+        if(syscall(__NR_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED_RSEQ, MEMBARRIER_CMD_FLAG_CPU, cpu) != 0) { // NOLINT(cppcoreguidelines-pro-type-vararg, hicpp-vararg)
+            // kernels before 5.10 can't target a single CPU
+            syscall(__NR_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED_RSEQ, 0, 0); // NOLINT(cppcoreguidelines-pro-type-vararg, hicpp-vararg)
+        }
+    }
+#else
+    static auto RseqAvailable() -> bool {
+        return false;
+    }
+
+    inline auto CurrentCache(std::uint32_t& /* cpu */) const -> CpuCache* {
+        return nullptr;
+    }
+
+    static inline auto TryPop(CpuCache& /* cache */, std::uint32_t /* cpu */, IndexSizeT& /* index */) -> SequenceResult {
+        return SequenceResult::Aborted;
+    }
+
+    static inline auto TryPush(CpuCache& /* cache */, std::uint32_t /* cpu */, IndexSizeT /* index */) -> SequenceResult {
+        return SequenceResult::Aborted;
+    }
+
+    static auto RestartCriticalSections(std::uint32_t /* cpu */) -> void {
+    }
+#endif
+
+    /**
+     * @brief Take indices from the shared indexer, moving the indices cached by all CPUs back to it if it has run out
+     *
+     */
+    inline auto TakeShared(IndexSizeT count, IndexSizeT* outIndices) -> IndexSizeT {
+        IndexSizeT taken = 0;
+        bool flushed = this->caches == nullptr;
+
+        // the shared indexer may return fewer indices than available, e.g. when its positions wrap
+        while(taken < count) {
+            const IndexSizeT batch = this->shared.Next(count - taken, outIndices + taken); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            if(batch == 0) {
+                if(flushed) {
+                    break;
+                }
+
+                this->Flush();
+                flushed = true;
+            }
+
+            taken += batch;
+        }
+
+        return taken;
+    }
+
+    /**
+     * @brief Refill the cache of the current CPU from the shared indexer, keeping one of the indices taken
+     *
+     */
+    auto Refill(CpuCache& cache, std::uint32_t cpu) -> IndexHolder {
+        std::array<IndexSizeT, RefillSize> refill{};
+        const IndexSizeT taken = this->TakeShared(RefillSize, refill.data());
+        if(taken == 0) {
+            return {};
+        }
+
+        for(IndexSizeT pos = 1 ; pos < taken ; pos++) {
+            if(TryPush(cache, cpu, refill[pos]) != SequenceResult::Committed) {
+                this->shared.Return(&refill[pos], taken - pos);
+                break;
+            }
+        }
+
+        return {refill[0]};
+    }
+
+  public:
+    /**
+     * @brief Construct a new Rseq Indexer with all indices in the shared indexer and empty CPU caches
+     *
+     * @param poolSize number of possible indices
+     */
+    RseqIndexer(IndexSizeT poolSize): shared(poolSize) {
+        if(RseqAvailable()) {
+            const long configuredCpus = sysconf(_SC_NPROCESSORS_CONF); // NOLINT(google-runtime-int)
+            this->cacheCount = configuredCpus > 0 ? static_cast<std::size_t>(configuredCpus) : 1;
+            this->caches = MakeAlignedArray<CpuCache>(this->cacheCount);
+        }
+    }
+
+    /**
+     * @brief Returns true if indices are cached per CPU, false if rseq is not available and the shared indexer is used directly
+     *
+     */
+    auto PerCpu() const -> bool {
+        return this->caches != nullptr;
+    }
+
+    /**
+     * @brief Get the next available index, from the cache of the current CPU if it has any
+     * if there are no more indices, the returning IndexHolder will be empty
+     *
+     * @return IndexHolder next available index
+     */
+    auto Next() -> IndexHolder {
+        std::uint32_t cpu = 0;
+        CpuCache* cache = this->CurrentCache(cpu);
+        if(cache != nullptr) {
+            IndexSizeT index = 0;
+            const SequenceResult result = TryPop(*cache, cpu, index);
+            if(likely(result == SequenceResult::Committed)) {
+                return {index};
+            }
+
+            if(result == SequenceResult::Unavailable) {
+                return this->Refill(*cache, cpu);
+            }
+        }
+
+        IndexSizeT index = 0;
+        if(this->TakeShared(1, &index) == 0) {
+            return {};
+        }
+
+        return {index};
+    }
+
+    /**
+     * @brief Return an index to the cache of the current CPU, or to the shared indexer if the cache is full.
+     * There are no checks for validity of the index so callers must ensure the index is within the range of the pool
+     * and that they have not been previously returned.
+     */
+    auto Return(IndexSizeT index) -> void {
+        std::uint32_t cpu = 0;
+        CpuCache* cache = this->CurrentCache(cpu);
+        if(cache != nullptr && likely(TryPush(*cache, cpu, index) == SequenceResult::Committed)) {
+            return;
+        }
+
+        this->shared.Return(index);
+    }
+
+    /**
+     * @brief Get up to count available indices, first from the cache of the current CPU and then from the shared indexer
+     *
+     * @param count maximum number of indices to retrieve
+     * @param outIndices destination of the retrieved indices. It must have space for at least count indices
+     * @return IndexSizeT number of indices written to outIndices. Zero if there are no more indices
+     */
+    auto Next(IndexSizeT count, IndexSizeT* outIndices) -> IndexSizeT {
+        IndexSizeT taken = 0;
+        std::uint32_t cpu = 0;
+        CpuCache* cache = this->CurrentCache(cpu);
+        if(cache != nullptr) {
+            while(taken < count && TryPop(*cache, cpu, outIndices[taken]) == SequenceResult::Committed) { // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                taken++;
+            }
+        }
+
+        if(taken < count) {
+            taken += this->TakeShared(count - taken, outIndices + taken); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        return taken;
+    }
+
+    /**
+     * @brief Return a batch of indices to the cache of the current CPU, and the indices that don't fit to the shared indexer
+     * in a single batch. The same restrictions of Return(IndexSizeT) apply to every index in the batch.
+     *
+     * @param returnedIndices indices to be returned
+     * @param count number of indices in returnedIndices
+     */
+    auto Return(const IndexSizeT* returnedIndices, IndexSizeT count) -> void {
+        IndexSizeT returned = 0;
+        std::uint32_t cpu = 0;
+        CpuCache* cache = this->CurrentCache(cpu);
+        if(cache != nullptr) {
+            while(returned < count && TryPush(*cache, cpu, returnedIndices[returned]) == SequenceResult::Committed) { // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                returned++;
+            }
+        }
+
+        if(returned < count) {
+            this->shared.Return(returnedIndices + returned, count - returned); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+    }
+
+    /**
+     * @brief Move the indices cached by all CPUs back to the shared indexer.
+     * Called when the shared indexer runs out of indices, so that indices cached by other CPUs can be taken
+     *
+     */
+    auto Flush() -> void {
+        for(std::size_t cpu = 0 ; cpu < this->cacheCount ; cpu++) {
+            CpuCache& cache = this->caches[cpu];
+            if(__atomic_load_n(&cache.count, __ATOMIC_RELAXED) == 0 || __atomic_exchange_n(&cache.locked, 1, __ATOMIC_ACQUIRE) != 0) {
+                continue;
+            }
+
+            RestartCriticalSections(static_cast<std::uint32_t>(cpu));
+
+            const IndexSizeT cached = __atomic_load_n(&cache.count, __ATOMIC_ACQUIRE);
+            if(cached > 0) {
+                this->shared.Return(cache.indices.data(), cached);
+                __atomic_store_n(&cache.count, 0, __ATOMIC_RELAXED);
+            }
+
+            __atomic_store_n(&cache.locked, 0, __ATOMIC_RELEASE);
+        }
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(RseqIndexer);
+    ~RseqIndexer() = default;
+};
+
+} // namespace dxpool
+#endif
@@ -0,0 +1,272 @@
+#ifndef SEGMENTED_POOL_H
+#define SEGMENTED_POOL_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+
+#include "AlignedMemory.h"
+#include "IndexHolder.h"
+#include "MutexIndexer.h"
+#include "Optimizers.h"
+#include "Pool.h"
+#include "PoolHandle.h"
+#include "PoolItem.h"
+#include "ResetPolicies.h"
+#include "TypePolicies.h"
+
+namespace dxpool {
+
+class InvalidSegmentedPoolArgumentsError: public std::invalid_argument {
+    using std::invalid_argument::invalid_argument;
+};
+
+/**
+ * @brief A thread safe data and object pool that grows in fixed size segments, up to a maximum capacity
+ *
+ * The pool starts with a single segment and a new segment is added whenever all existing segments run out of items,
+ * until the maximum number of segments is reached. Segments are never released or moved while the pool exists,
+ * so as with Pool, items never have their memory position changed.
+ *
+ * Each segment has its own indexer. Taking, accessing and returning items never block on growth,
+ * only threads adding a new segment synchronize with each other.
+ *
+ * ItemType must be default constructible and its destructor is only invoked when the pool is destroyed.
+ *
+ * A pool cannot be copied or moved.
+ *
+ * @tparam ItemType type of the data to be stored
+ * @tparam Indexer type of indexer used by each segment
+ * @tparam ResetPolicy functor resetting items, invoked with a pointer to the item: MemberReset, NoReset, CallbackReset
+ *         or any other type with such call operator, as in BasicPool
+ */
+template<typename ItemType, typename Indexer = MutexIndexer, typename ResetPolicy = DefaultReset<ItemType>>
+class SegmentedPool final {
+  public:
+    /**
+     * @brief Type of the items stored in the pool
+     *
+     */
+    using ValueType = ItemType;
+
+    /**
+     * @brief Handle type returned by TakeHandle, bound to this pool type
+     *
+     */
+    using Handle = PoolHandle<SegmentedPool>;
+
+  private:
+    friend Handle;
+
+    using CustomResetCallbackT = std::function<void(ItemType*)>;
+
+    /**
+     * @brief Determines if the reset policy can be created from a reset callback, as CallbackReset
+     *
+     */
+    template<typename Policy>
+    using AcceptsResetCallback = std::is_constructible<Policy, const CustomResetCallbackT&>;
+
+    struct Segment {
+        std::unique_ptr<ItemType[]> items;
+        Indexer indexer;
+
+        Segment(IndexSizeT segmentSize): items(new ItemType[segmentSize]()), indexer(segmentSize) {
+        }
+    };
+
+    ResetPolicy resetPolicy{};
+
+    const IndexSizeT segmentSize;
+    const IndexSizeT maxSegments;
+
+    std::unique_ptr<std::atomic<Segment*>[]> segments;
+    std::atomic<IndexSizeT> segmentCount{0};
+    // segment where the last item was found, where the search for the next item starts
+    std::atomic<IndexSizeT> lastUsedSegment{0};
+    std::mutex growMutex;
+
+    inline auto InvokeReset(ItemType* item) -> void {
+        this->resetPolicy(item);
+    }
+
+    inline auto SegmentAt(IndexSizeT index) const -> Segment* {
+        return this->segments[index / this->segmentSize].load(std::memory_order_acquire);
+    }
+
+    inline auto ItemAt(IndexSizeT index) -> ItemType* {
+        return &this->SegmentAt(index)->items[index % this->segmentSize];
+    }
+
+    inline auto ReturnIndex(IndexSizeT index) -> void {
+        this->InvokeReset(this->ItemAt(index));
+        this->SegmentAt(index)->indexer.Return(index % this->segmentSize);
+    }
+
+    /**
+     * @brief Add a new segment unless another thread already did since observedCount was read
+     *
+     * @param observedCount number of segments seen by the caller
+     * @return true if there are new segments to look for items
+     * @return false if the pool reached its maximum capacity
+     */
+    auto Grow(IndexSizeT observedCount) -> bool {
+        std::lock_guard<std::mutex> lock(this->growMutex);
+
+        const IndexSizeT currentCount = this->segmentCount.load(std::memory_order_acquire);
+        if(currentCount != observedCount) {
+            return true;
+        }
+
+        if(currentCount == this->maxSegments) {
+            return false;
+        }
+
+        // segments hold the indexer, which may be over-aligned
+        this->segments[currentCount].store(MakeAligned<Segment>(this->segmentSize).release(), std::memory_order_release);
+        this->segmentCount.store(currentCount + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Find a free index in any segment, growing the pool if required
+     *
+     */
+    auto NextIndex() -> IndexHolder {
+        while(true) {
+            const IndexSizeT count = this->segmentCount.load(std::memory_order_acquire);
+            const IndexSizeT start = this->lastUsedSegment.load(std::memory_order_relaxed);
+
+            for(IndexSizeT i = 0 ; i < count ; i++) {
+                const IndexSizeT segmentIndex = (start + i) % count;
+                auto holder = this->segments[segmentIndex].load(std::memory_order_acquire)->indexer.Next();
+
+                if(likely(!holder.Empty())) {
+                    if(segmentIndex != start) {
+                        this->lastUsedSegment.store(segmentIndex, std::memory_order_relaxed);
+                    }
+
+                    return {segmentIndex * this->segmentSize + holder.Get()};
+                }
+            }
+
+            if(!this->Grow(count)) {
+                return {};
+            }
+        }
+    }
+
+  public:
+    /**
+     * @brief Construct a new segmented pool with one segment
+     *
+     * @param itemsPerSegment number of items in each segment. It must be greater than zero
+     * @param maxSegmentCount maximum number of segments. It must be greater than zero
+     * @throws InvalidSegmentedPoolArgumentsError if the segment size or maximum number of segments are zero
+     */
+    SegmentedPool(IndexSizeT itemsPerSegment, IndexSizeT maxSegmentCount) noexcept(false)
+        : segmentSize(itemsPerSegment), maxSegments(maxSegmentCount), segments(new std::atomic<Segment*>[maxSegmentCount]) {
+
+        if(itemsPerSegment == 0 || maxSegmentCount == 0) {
+            throw InvalidSegmentedPoolArgumentsError("Segment size and maximum number of segments must be greater than zero");
+        }
+
+        for(IndexSizeT i = 0 ; i < maxSegmentCount ; i++) {
+            this->segments[i].store(nullptr, std::memory_order_relaxed);
+        }
+
+        this->Grow(0);
+    }
+
+    /**
+     * @brief Construct a new segmented pool with one segment and a custom reset callback
+     *
+     * @param itemsPerSegment number of items in each segment. It must be greater than zero
+     * @param maxSegmentCount maximum number of segments. It must be greater than zero
+     * @param resetCb item state reset callback to be invoked immediately before the item is returned to the pool
+     */
+    template<typename Policy = ResetPolicy, typename = typename std::enable_if<AcceptsResetCallback<Policy>::value>::type>
+    SegmentedPool(IndexSizeT itemsPerSegment, IndexSizeT maxSegmentCount, const CustomResetCallbackT& resetCb) noexcept(false)
+        : SegmentedPool(itemsPerSegment, maxSegmentCount) {
+        this->resetPolicy = ResetPolicy(resetCb);
+    }
+
+    /**
+     * @brief Remove and return an element from the pool, adding a new segment if all segments are empty
+     *
+     * @return PoolItem<ItemType> will be empty if the pool reached its maximum capacity and there are no more items
+     */
+    inline auto Take() -> PoolItem<ItemType> {
+        auto holder = this->NextIndex();
+
+        if(holder.Empty()) {
+            return {};
+        }
+
+        auto returnToPoolFn = [this](const PoolItem<ItemType>& item) -> void{
+            this->ReturnIndex(item.PoolIndex());
+        };
+
+        const auto index = holder.Get();
+        return PoolItem<ItemType>(returnToPoolFn, this->ItemAt(index), index);
+    }
+
+    /**
+     * @brief Remove and return an element from the pool wrapped in a handle bound to this pool type,
+     * adding a new segment if all segments are empty
+     *
+     * @return Handle will be empty if the pool reached its maximum capacity and there are no more items
+     */
+    inline auto TakeHandle() -> Handle {
+        auto holder = this->NextIndex();
+
+        if(holder.Empty()) {
+            return {};
+        }
+
+        return Handle(this, holder.Get());
+    }
+
+    /**
+     * @brief Returns the current number of items in the pool, which grows as segments are added
+     *
+     * @return size_t number of items in all segments
+     */
+    auto Size() const -> size_t {
+        return this->segmentCount.load(std::memory_order_acquire) * this->segmentSize;
+    }
+
+    /**
+     * @brief Returns the maximum number of items the pool can grow to
+     *
+     * @return size_t maximum capacity of the pool
+     */
+    auto Capacity() const -> size_t {
+        return this->maxSegments * this->segmentSize;
+    }
+
+    /**
+     * @brief Returns the number of items in each segment
+     *
+     * @return size_t segment size
+     */
+    auto SegmentSize() const -> size_t {
+        return this->segmentSize;
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(SegmentedPool);
+
+    ~SegmentedPool() {
+        const IndexSizeT count = this->segmentCount.load(std::memory_order_acquire);
+        for(IndexSizeT i = 0 ; i < count ; i++) {
+            AlignedDelete{}(this->segments[i].load(std::memory_order_relaxed));
+        }
+    }
+}; // class SegmentedPool
+
+} // namespace dxpool
+
+#endif // SEGMENTED_POOL_H
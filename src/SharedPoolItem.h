@@ -0,0 +1,148 @@
+#ifndef SHARED_POOL_ITEM_H
+#define SHARED_POOL_ITEM_H
+
+#include <cstdint>
+#include <utility>
+
+#include "IndexHolder.h"
+
+namespace dxpool {
+
+/**
+ * @brief Reference counted handle to an item taken from a pool, statically bound to the type of the owning pool.
+ *
+ * Shared pool items can be copied to hand the same item to several consumers. The reference count is kept
+ * by the pool for each of its items, so copying only costs an atomic increment and never allocates.
+ * When the last copy is destroyed, the item is reset and returned to the pool.
+ *
+ * Consumers sharing an item must synchronize their access to the item itself.
+ *
+ * @tparam PoolType type of the pool that owns the item
+ */
+template<typename PoolType>
+class SharedPoolItem final {
+  public:
+    /**
+     * @brief Type of the item held by this shared item
+     *
+     */
+    using ItemType = typename PoolType::ValueType;
+
+  private:
+    PoolType* pool{nullptr};
+    IndexSizeT index{0};
+
+    auto Release() -> void {
+        if(this->pool != nullptr) {
+            this->pool->ReleaseReference(this->index);
+            this->pool = nullptr;
+        }
+    }
+
+  public:
+    /**
+     * @brief The default constructor creates an empty shared item
+     *
+     */
+    SharedPoolItem() = default;
+
+    /**
+     * @brief Construct a new shared item holding the only reference to an item taken from a pool
+     *
+     * @param ownerPool pool the item was taken from and where it will be returned to
+     * @param poolIndex index of the item in the pool
+     */
+    SharedPoolItem(PoolType* ownerPool, IndexSizeT poolIndex) noexcept : pool(ownerPool), index(poolIndex) {
+    }
+
+    /**
+     * @brief Copy constructor, adding a reference to the item
+     *
+     * @param sharedItem shared item to be copied
+     */
+    SharedPoolItem(const SharedPoolItem& sharedItem) noexcept : pool(sharedItem.pool), index(sharedItem.index) {
+        if(this->pool != nullptr) {
+            this->pool->AddReference(this->index);
+        }
+    }
+
+    /**
+     * @brief Move constructor. After moved, the shared item is considered empty
+     *
+     * @param movedItem shared item to be moved
+     */
+    SharedPoolItem(SharedPoolItem&& movedItem) noexcept : pool(movedItem.pool), index(movedItem.index) {
+        movedItem.pool = nullptr;
+    }
+
+    /**
+     * @brief Copy assignment, releasing the item held, if any, and adding a reference to the copied item
+     *
+     */
+    auto operator=(const SharedPoolItem& sharedItem) noexcept -> SharedPoolItem& {
+        SharedPoolItem copy(sharedItem);
+        return *this = std::move(copy);
+    }
+
+    /**
+     * @brief Move assignment, releasing the item held, if any. After moved, the other shared item is considered empty
+     *
+     */
+    auto operator=(SharedPoolItem&& movedItem) noexcept -> SharedPoolItem& {
+        if(this != &movedItem) {
+            this->Release();
+            this->pool = movedItem.pool;
+            this->index = movedItem.index;
+            movedItem.pool = nullptr;
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Returns true if there is no item held
+     *
+     */
+    auto Empty() const -> bool {
+        return this->pool == nullptr;
+    }
+
+    /**
+     * @brief Returns a pointer to the item held.
+     * If there is no item held (i.e, Empty() is true) the behaviour of this function is undefined
+     *
+     */
+    auto Get() const -> ItemType* {
+        return this->pool->ItemAt(this->index);
+    }
+
+    /**
+     * @brief Returns the index of the item in the pool. If there is no item held, the returned value is undefined
+     *
+     * @return IndexSizeT index position
+     */
+    auto PoolIndex() const -> IndexSizeT {
+        return this->index;
+    }
+
+    /**
+     * @brief Returns the number of shared items currently referencing the item, zero if empty.
+     * The value may be outdated as soon as it's returned if other threads hold copies
+     *
+     */
+    auto UseCount() const -> std::uint32_t {
+        return this->pool == nullptr ? 0 : this->pool->ReferenceCount(this->index);
+    }
+
+    /**
+     * @brief Destruction releases this reference, returning the item to the pool if it was the last one
+     *
+     */
+    ~SharedPoolItem() {
+        this->Release();
+    }
+};
+
+} // namespace dxpool
+
+#endif // SHARED_POOL_ITEM_H
@@ -0,0 +1,220 @@
+#ifndef SOA_POOL_H
+#define SOA_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+
+#include "IndexHolder.h"
+#include "MutexIndexer.h"
+#include "ResetPolicies.h"
+#include "TypePolicies.h"
+
+namespace dxpool {
+
+/**
+ * @brief List of the field types of the items in a SoAPool
+ *
+ */
+template<typename... FieldTypes>
+struct SoAFields {};
+
+template<std::size_t... Indices>
+struct FieldIndices {};
+
+template<std::size_t Count, std::size_t... Indices>
+struct MakeFieldIndices: MakeFieldIndices<Count - 1, Count - 1, Indices...> {};
+
+template<std::size_t... Indices>
+struct MakeFieldIndices<0, Indices...> {
+    using Type = FieldIndices<Indices...>;
+};
+
+template<typename Fields, typename IndexerPolicy = MutexIndexer, typename ResetPolicy = NoReset>
+class SoAPool;
+
+/**
+ * @brief A fixed size, thread safe pool laid out as a struct of arrays: each field of the items is stored
+ * in its own contiguous array, indexed by the indices handed out by the indexer.
+ *
+ * Scanning one field of all items, e.g. a deadline, only reads that field's array, which is dense in cache
+ * and can be vectorized, instead of loading whole items with every cold field next to it.
+ * Fields are identified by their position in SoAFields, so an enum naming the positions makes accessors readable.
+ *
+ * Field types must be default constructible, they're value initialized when the pool is created
+ * and destroyed with the pool. Items are returned as they are, unless a reset policy is given.
+ *
+ * A pool cannot be copied or moved.
+ *
+ * @tparam FieldTypes types of the fields of each item
+ * @tparam IndexerPolicy type of indexer to be used to when retrieving and returning items.
+           The indexer defines the concurrency behaviour when using the pool in a multi-threaded context
+ * @tparam ResetPolicy functor resetting an item before it's returned to the pool, invoked with a pointer to each
+ *         of the item's fields, in the order of SoAFields. NoReset returns items as they are
+ */
+template<typename... FieldTypes, typename IndexerPolicy, typename ResetPolicy>
+class SoAPool<SoAFields<FieldTypes...>, IndexerPolicy, ResetPolicy> final {
+  public:
+    /**
+     * @brief Type of the field at position FieldIndex
+     *
+     */
+    template<std::size_t FieldIndex>
+    using FieldType = typename std::tuple_element<FieldIndex, std::tuple<FieldTypes...>>::type;
+
+    /**
+     * @brief Handle to an item taken from the pool, giving access to its fields.
+     * The item is returned to the pool when the handle is destroyed. Handles can be moved but not copied
+     *
+     */
+    class Handle final {
+      private:
+        SoAPool* pool{nullptr};
+        IndexSizeT index{0};
+
+      public:
+        /**
+         * @brief The default constructor creates an empty handle
+         *
+         */
+        Handle() = default;
+
+        /**
+         * @brief Construct a new handle for an item taken from a pool
+         *
+         * @param ownerPool pool the item was taken from and where it will be returned to
+         * @param poolIndex index of the item in the pool
+         */
+        Handle(SoAPool* ownerPool, IndexSizeT poolIndex) noexcept : pool(ownerPool), index(poolIndex) {
+        }
+
+        /**
+         * @brief Move constructor for a handle. After moved, the handle is considered empty
+         *
+         * @param movedHandle handle to be moved
+         */
+        Handle(Handle&& movedHandle) noexcept : pool(movedHandle.pool), index(movedHandle.index) {
+            movedHandle.pool = nullptr;
+        }
+
+        auto operator=(Handle&&) -> Handle& = delete;
+        Handle(const Handle&) = delete;
+        auto operator=(const Handle&) -> Handle& = delete;
+
+        /**
+         * @brief Returns true if there is no item held by this handle
+         *
+         */
+        auto Empty() const -> bool {
+            return this->pool == nullptr;
+        }
+
+        /**
+         * @brief Returns a reference to a field of the item held by this handle.
+         * If there is no item held (i.e, Empty() is true) the behaviour of this function is undefined
+         *
+         * @tparam FieldIndex position of the field in SoAFields
+         */
+        template<std::size_t FieldIndex>
+        auto Field() const -> FieldType<FieldIndex>& {
+            return this->pool->template FieldData<FieldIndex>()[this->index];
+        }
+
+        /**
+         * @brief Returns the index of the item in the pool. If there is no item held, the returned value is undefined
+         *
+         * @return IndexSizeT index position
+         */
+        auto PoolIndex() const -> IndexSizeT {
+            return this->index;
+        }
+
+        /**
+         * @brief Destruction returns the item to the pool, if there's one held
+         *
+         */
+        ~Handle() {
+            if(this->pool != nullptr) {
+                this->pool->ReturnIndex(this->index);
+            }
+        }
+    };
+
+  private:
+    const std::size_t numItems;
+    std::tuple<std::unique_ptr<FieldTypes[]>...> fields;
+    IndexerPolicy indexer;
+    ResetPolicy resetPolicy{};
+
+    template<typename FieldT>
+    static auto MakeFieldArray(std::size_t count) -> std::unique_ptr<FieldT[]> {
+        return std::unique_ptr<FieldT[]>(new FieldT[count]());
+    }
+
+    template<std::size_t... Indices>
+    inline auto InvokeReset(IndexSizeT index, FieldIndices<Indices...> /* indices */) -> void {
+        this->resetPolicy(&std::get<Indices>(this->fields)[index]...);
+    }
+
+    inline auto ReturnIndex(IndexSizeT index) -> void {
+        this->InvokeReset(index, typename MakeFieldIndices<sizeof...(FieldTypes)>::Type{});
+        this->indexer.Return(index);
+    }
+
+  public:
+    /**
+     * @brief Construct a new SoA pool
+     *
+     * @param poolSize number of items in the pool
+     */
+    explicit SoAPool(std::size_t poolSize):
+        numItems(poolSize), fields(MakeFieldArray<FieldTypes>(poolSize)...), indexer(poolSize) {
+    }
+
+    /**
+     * @brief Remove and return an item from the pool, if not empty
+     *
+     * @return Handle will be empty if there are no more items in the pool
+     */
+    inline auto Take() -> Handle {
+        auto holder = this->indexer.Next();
+        if(holder.Empty()) {
+            return {};
+        }
+
+        return Handle(this, holder.Get());
+    }
+
+    /**
+     * @brief Returns the array holding one field of all items, indexed by PoolIndex, with Size() elements.
+     * Fields of items not taken hold their initial or last reset value
+     *
+     * @tparam FieldIndex position of the field in SoAFields
+     */
+    template<std::size_t FieldIndex>
+    inline auto FieldData() -> FieldType<FieldIndex>* {
+        return std::get<FieldIndex>(this->fields).get();
+    }
+
+    template<std::size_t FieldIndex>
+    inline auto FieldData() const -> const FieldType<FieldIndex>* {
+        return std::get<FieldIndex>(this->fields).get();
+    }
+
+    /**
+     * @brief Returns the total size of the pool when created
+     *
+     * @return size_t size of the pool
+     */
+    auto Size() const -> std::size_t {
+        return this->numItems;
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(SoAPool);
+    ~SoAPool() = default;
+};
+
+} // namespace dxpool
+
+#endif // SOA_POOL_H
@@ -0,0 +1,236 @@
+#ifndef STACK_INDEXER_H
+#define STACK_INDEXER_H
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+#include "ConcurrentIndexer.h"
+#include "IndexHolder.h"
+#include "PoolStats.h"
+#include "TypePolicies.h"
+
+namespace dxpool {
+
+class InvalidStackIndexerArgumentsError: public std::invalid_argument {
+    using std::invalid_argument::invalid_argument;
+};
+
+/**
+ * @brief Lock-free LIFO indexer, a Treiber stack of indices.
+ *
+ * The most recently returned index is the next one taken, so under light load the same few items are reused
+ * and stay in cache, while a FIFO indexer such as ConcurrentIndexer cycles through every item of the pool.
+ *
+ * Free indices are linked through an array holding, for each index, the index below it in the stack.
+ * The head of the stack packs the top index and a tag into a single 64 bit word. The tag changes on every update,
+ * so a compare and swap fails if the head was popped and pushed back in between (the ABA problem), even when the
+ * top index is the same. Indices must fit in 32 bits.
+ *
+ * @tparam StatsPolicy statistics collected by the indexer, NoStats or ShardedStats. With ShardedStats the indexer
+ *         also counts compare and swap retries
+ */
+template<typename StatsPolicy = NoStats>
+class BasicStackIndexer final {
+  private:
+    static constexpr const std::uint32_t EmptyTop = std::numeric_limits<std::uint32_t>::max();
+    static constexpr const unsigned TagShift = 32;
+
+    alignas(AtomicAlignment) std::atomic<std::uint64_t> head;
+
+    std::unique_ptr<std::atomic<std::uint32_t>[]> below;
+
+    // only updated with statistics enabled, to observe the number of indices in use
+    std::atomic<IndexSizeT> inUse{0};
+
+    StatsPolicy stats;
+
+    static inline auto Top(std::uint64_t headValue) -> std::uint32_t {
+        return static_cast<std::uint32_t>(headValue);
+    }
+
+    static inline auto MakeHead(std::uint64_t previousHead, std::uint32_t top) -> std::uint64_t {
+        const std::uint64_t tag = (previousHead >> TagShift) + 1;
+        return (tag << TagShift) | top;
+    }
+
+    inline auto RecordTaken(IndexSizeT taken) -> void {
+        if(!StatsPolicy::Enabled) {
+            return;
+        }
+
+        this->stats.Add(PoolStat::Taken, taken);
+        this->stats.ObserveInUse(this->inUse.fetch_add(taken, std::memory_order_relaxed) + taken);
+    }
+
+    inline auto RecordReturned(IndexSizeT returned) -> void {
+        if(!StatsPolicy::Enabled) {
+            return;
+        }
+
+        this->inUse.fetch_sub(returned, std::memory_order_relaxed);
+        this->stats.Add(PoolStat::Returned, returned);
+    }
+
+    /**
+     * @brief Push a chain of indices, already linked from first to last, on top of the stack
+     *
+     */
+    inline auto PushChain(std::uint32_t first, std::uint32_t last) -> void {
+        std::uint64_t curHead = this->head.load(std::memory_order_relaxed);
+
+        while(true) {
+            this->below[last].store(Top(curHead), std::memory_order_relaxed);
+
+            if(this->head.compare_exchange_weak(curHead, MakeHead(curHead, first), std::memory_order_release, std::memory_order_relaxed)) {
+                return;
+            }
+
+            this->stats.Add(PoolStat::CASRetries, 1);
+        }
+    }
+
+  public:
+    /**
+     * @brief Construct a new Stack Indexer holding all indices from 0 to poolSize - 1
+     *
+     * @param poolSize number of possible indices
+     * @throws InvalidStackIndexerArgumentsError if poolSize indices don't fit in 32 bits
+     */
+    BasicStackIndexer(IndexSizeT poolSize) {
+        if(poolSize >= EmptyTop) {
+            throw InvalidStackIndexerArgumentsError("Stack indexer size must be smaller than 2^32 - 1");
+        }
+
+        // index 0 is the top of the stack and every index is linked to the next one, so indices are first taken in order
+        this->below.reset(new std::atomic<std::uint32_t>[poolSize]);
+        for(IndexSizeT i = 0 ; i < poolSize ; i++) {
+            this->below[i].store(i + 1 < poolSize ? static_cast<std::uint32_t>(i + 1) : EmptyTop, std::memory_order_relaxed);
+        }
+
+        this->head.store(poolSize > 0 ? 0 : EmptyTop, std::memory_order_release);
+    }
+
+    /**
+     * @brief Get the most recently returned index
+     * if there are no more indices, the returning IndexHolder will be empty
+     *
+     * @return IndexHolder next available index
+     */
+    auto Next() -> IndexHolder {
+        std::uint64_t curHead = this->head.load(std::memory_order_acquire);
+
+        while(true) {
+            const std::uint32_t top = Top(curHead);
+            if(top == EmptyTop) {
+                this->stats.Add(PoolStat::TakeFailures, 1);
+                return {};
+            }
+
+            // the index below may be stale if top was taken in the meantime, in which case the tag has changed and the swap fails
+            const std::uint32_t newTop = this->below[top].load(std::memory_order_relaxed);
+            if(this->head.compare_exchange_weak(curHead, MakeHead(curHead, newTop), std::memory_order_acquire, std::memory_order_acquire)) {
+                this->RecordTaken(1);
+                return {top};
+            }
+
+            this->stats.Add(PoolStat::CASRetries, 1);
+        }
+    }
+
+    /**
+     * @brief Return an index to the top of the stack.
+     * There are no checks for validity of the index so callers must ensure the index is within the range of the pool
+     * and that they have not been previously returned.
+     */
+    auto Return(IndexSizeT index) -> void {
+        const auto stackIndex = static_cast<std::uint32_t>(index);
+        this->PushChain(stackIndex, stackIndex);
+        this->RecordReturned(1);
+    }
+
+    /**
+     * @brief Get up to count available indices, unlinking them from the top of the stack with a single compare and swap
+     *
+     * @param count maximum number of indices to retrieve
+     * @param outIndices destination of the retrieved indices. It must have space for at least count indices
+     * @return IndexSizeT number of indices written to outIndices. Zero if there are no more indices
+     */
+    auto Next(IndexSizeT count, IndexSizeT* outIndices) -> IndexSizeT {
+        if(count == 0) {
+            return 0;
+        }
+
+        std::uint64_t curHead = this->head.load(std::memory_order_acquire);
+
+        while(true) {
+            IndexSizeT taken = 0;
+            std::uint32_t newTop = Top(curHead);
+            while(taken < count && newTop != EmptyTop) {
+                outIndices[taken] = newTop; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                taken++;
+                newTop = this->below[newTop].load(std::memory_order_relaxed);
+            }
+
+            if(taken == 0) {
+                this->stats.Add(PoolStat::TakeFailures, 1);
+                return 0;
+            }
+
+            if(this->head.compare_exchange_weak(curHead, MakeHead(curHead, newTop), std::memory_order_acquire, std::memory_order_acquire)) {
+                this->RecordTaken(taken);
+                if(taken < count) {
+                    this->stats.Add(PoolStat::TakeFailures, 1);
+                }
+
+                return taken;
+            }
+
+            this->stats.Add(PoolStat::CASRetries, 1);
+        }
+    }
+
+    /**
+     * @brief Return a batch of indices, linking them together first and pushing them with a single compare and swap.
+     * The first index of the batch ends up on top of the stack.
+     * The same restrictions of Return(IndexSizeT) apply to every index in the batch.
+     *
+     * @param returnedIndices indices to be returned
+     * @param count number of indices in returnedIndices
+     */
+    auto Return(const IndexSizeT* returnedIndices, IndexSizeT count) -> void {
+        if(count == 0) {
+            return;
+        }
+
+        for(IndexSizeT i = 0 ; i + 1 < count ; i++) {
+            this->below[returnedIndices[i]].store(static_cast<std::uint32_t>(returnedIndices[i + 1]), std::memory_order_relaxed); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        this->PushChain(static_cast<std::uint32_t>(returnedIndices[0]), static_cast<std::uint32_t>(returnedIndices[count - 1])); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        this->RecordReturned(count);
+    }
+
+    /**
+     * @brief Returns the statistics collected by the indexer. Empty when using NoStats
+     *
+     * @return PoolStatsSnapshot counter values
+     */
+    auto Stats() const -> PoolStatsSnapshot {
+        return this->stats.Snapshot();
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(BasicStackIndexer);
+    ~BasicStackIndexer() = default;
+};
+
+/**
+ * @brief Lock-free LIFO indexer without statistics
+ *
+ */
+using StackIndexer = BasicStackIndexer<NoStats>;
+
+} // namespace dxpool
+#endif
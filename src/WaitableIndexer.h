@@ -0,0 +1,162 @@
+#ifndef WAITABLE_INDEXER_H
+#define WAITABLE_INDEXER_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "ConcurrentIndexer.h"
+#include "Futex.h"
+#include "IndexHolder.h"
+#include "Optimizers.h"
+#include "TypePolicies.h"
+
+namespace dxpool {
+
+/**
+ * @brief Indexer that lets callers block until an index is available, in front of another indexer.
+ *
+ * Threads waiting for an index sleep on a futex (see Futex) and are woken up when indices are returned.
+ * Returning indices only pays for a wake up system call while there are threads waiting.
+ *
+ * Pools using this indexer provide TakeWait and TakeFor.
+ *
+ * @tparam Indexer indexer holding the indices, e.g. MutexIndexer or ConcurrentIndexer
+ */
+template<typename Indexer = ConcurrentIndexer>
+class WaitableIndexer final {
+  private:
+    Indexer indexer;
+    Futex futex;
+    std::atomic<std::uint32_t> waiters{0};
+
+    inline auto NotifyWaiters(IndexSizeT count) -> void {
+        // pairs with the increment of waiters in TryNextOrWait: either this thread sees the waiter,
+        // or the waiter sees the index just returned when it tries again
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if(unlikely(this->waiters.load(std::memory_order_relaxed) > 0)) {
+            this->futex.Notify(static_cast<std::uint32_t>(std::min<IndexSizeT>(count, UINT32_MAX)));
+        }
+    }
+
+    /**
+     * @brief Try to get an index and sleep using waitFn if there's none, returning empty if woken without an index
+     *
+     */
+    template<typename WaitFn>
+    auto TryNextOrWait(WaitFn waitFn) -> IndexHolder {
+        auto holder = this->indexer.Next();
+        if(likely(!holder.Empty())) {
+            return holder;
+        }
+
+        const std::uint32_t observed = this->futex.Value();
+        this->waiters.fetch_add(1, std::memory_order_seq_cst);
+
+        holder = this->indexer.Next();
+        if(holder.Empty()) {
+            waitFn(observed);
+        }
+
+        this->waiters.fetch_sub(1, std::memory_order_relaxed);
+        return holder;
+    }
+
+  public:
+    /**
+     * @brief Construct a new Waitable Indexer
+     *
+     * @param poolSize number of possible indices
+     */
+    WaitableIndexer(IndexSizeT poolSize): indexer(poolSize) {
+    }
+
+    /**
+     * @brief Get the next available index without waiting.
+     * if there are no more indices, the returning IndexHolder will be empty
+     *
+     * @return IndexHolder next available index
+     */
+    inline auto Next() -> IndexHolder {
+        return this->indexer.Next();
+    }
+
+    /**
+     * @brief Get the next available index, blocking until one is returned if there are none
+     *
+     * @return IndexHolder next available index, never empty
+     */
+    auto NextWait() -> IndexHolder {
+        while(true) {
+            auto holder = this->TryNextOrWait([this](std::uint32_t observed) {
+                this->futex.Wait(observed);
+            });
+
+            if(!holder.Empty()) {
+                return holder;
+            }
+        }
+    }
+
+    /**
+     * @brief Get the next available index, blocking up to timeout until one is returned if there are none
+     *
+     * @param timeout maximum time to wait for an index
+     * @return IndexHolder next available index, empty if the timeout elapsed
+     */
+    auto NextFor(std::chrono::nanoseconds timeout) -> IndexHolder {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+        while(true) {
+            auto holder = this->TryNextOrWait([this, deadline](std::uint32_t observed) {
+                this->futex.WaitFor(observed, deadline - std::chrono::steady_clock::now());
+            });
+
+            if(!holder.Empty() || std::chrono::steady_clock::now() >= deadline) {
+                return holder;
+            }
+        }
+    }
+
+    /**
+     * @brief Return an index, waking up a waiting thread if there's any.
+     * The same restrictions of the underlying indexer apply
+     *
+     * @param index index to be returned
+     */
+    inline auto Return(IndexSizeT index) -> void {
+        this->indexer.Return(index);
+        this->NotifyWaiters(1);
+    }
+
+    /**
+     * @brief Get up to count available indices without waiting
+     *
+     * @param count maximum number of indices to retrieve
+     * @param outIndices destination of the retrieved indices. It must have space for at least count indices
+     * @return IndexSizeT number of indices written to outIndices. Zero if there are no more indices
+     */
+    inline auto Next(IndexSizeT count, IndexSizeT* outIndices) -> IndexSizeT {
+        return this->indexer.Next(count, outIndices);
+    }
+
+    /**
+     * @brief Return a batch of indices, waking up as many waiting threads as indices returned
+     *
+     * @param returnedIndices indices to be returned
+     * @param count number of indices in returnedIndices
+     */
+    inline auto Return(const IndexSizeT* returnedIndices, IndexSizeT count) -> void {
+        this->indexer.Return(returnedIndices, count);
+        this->NotifyWaiters(count);
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(WaitableIndexer);
+    ~WaitableIndexer() = default;
+};
+
+} // namespace dxpool
+
+#endif // WAITABLE_INDEXER_H
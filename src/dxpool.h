@@ -2,6 +2,7 @@
 #define DXPOOL_H
 
 #include "Pool.h"
+#include "SegmentedPool.h"
 #include "WorkerPool.h"
 #include "Processor.h"
 
@@ -4,42 +4,73 @@
 #include <set>
 
 #include "../src/MutexIndexer.h"
+#include "../src/BitmapIndexer.h"
 #include "../src/ConcurrentIndexer.h"
+#include "../src/MagazineIndexer.h"
+#include "../src/RingIndexer.h"
+#include "../src/RseqIndexer.h"
+#include "../src/StackIndexer.h"
+#include "../src/WaitableIndexer.h"
 
 #include "IndexerTemplateTest.h"
 
 using namespace dxpool;
 using namespace std;
 
-TEMPLATE_TEST_CASE_METHOD(IndexerFixture, "Get all indices", "[indexer]", MutexIndexer, ConcurrentIndexer) {  // NOLINT
+using ConcurrentMagazineIndexer = MagazineIndexer<ConcurrentIndexer>;
+using SmallMutexMagazineIndexer = MagazineIndexer<MutexIndexer, 4>;
+using WaitableMutexIndexer = WaitableIndexer<MutexIndexer>;
+using WaitableConcurrentIndexer = WaitableIndexer<ConcurrentIndexer>;
+using MutexIndexerWithStats = BasicMutexIndexer<ShardedStats>;
+using ConcurrentIndexerWithStats = BasicConcurrentIndexer<ShardedStats>;
+using StackIndexerWithStats = BasicStackIndexer<ShardedStats>;
+using BitmapIndexerWithStats = BasicBitmapIndexer<ShardedStats>;
+using ConcurrentRseqIndexer = RseqIndexer<ConcurrentIndexer>;
+using SmallMutexRseqIndexer = RseqIndexer<MutexIndexer, 4>;
+using TicketLockIndexerWithStats = BasicMutexIndexer<ShardedStats, TicketLock>;
+using RingIndexerWithStats = BasicRingIndexer<ShardedStats>;
+
+TEMPLATE_TEST_CASE_METHOD(IndexerFixture, "Get all indices", "[indexer]", MutexIndexer, ConcurrentIndexer, ConcurrentMagazineIndexer, SmallMutexMagazineIndexer, WaitableMutexIndexer, WaitableConcurrentIndexer, MutexIndexerWithStats, ConcurrentIndexerWithStats, StackIndexer, StackIndexerWithStats, BitmapIndexer, BitmapIndexerWithStats, ConcurrentRseqIndexer, SmallMutexRseqIndexer, SpinLockIndexer, TicketLockIndexer, AdaptiveLockIndexer, TicketLockIndexerWithStats, RingIndexer, RingIndexerWithStats) {  // NOLINT
     IndexerFixture<TestType>::GetAllIndices();
 }
 
-TEMPLATE_TEST_CASE_METHOD(IndexerFixture, "Get and return one index", "[indexer]", MutexIndexer, ConcurrentIndexer) {  // NOLINT
+TEMPLATE_TEST_CASE_METHOD(IndexerFixture, "Get and return one index", "[indexer]", MutexIndexer, ConcurrentIndexer, ConcurrentMagazineIndexer, SmallMutexMagazineIndexer, WaitableMutexIndexer, WaitableConcurrentIndexer, MutexIndexerWithStats, ConcurrentIndexerWithStats, StackIndexer, StackIndexerWithStats, BitmapIndexer, BitmapIndexerWithStats, ConcurrentRseqIndexer, SmallMutexRseqIndexer, SpinLockIndexer, TicketLockIndexer, AdaptiveLockIndexer, TicketLockIndexerWithStats, RingIndexer, RingIndexerWithStats) {  // NOLINT
     IndexerFixture<TestType>::GetAndReturnOneIndex();
 }
 
-TEMPLATE_TEST_CASE_METHOD(IndexerFixture, "Get and return one index multiple times", "[indexer]", MutexIndexer, ConcurrentIndexer) {  // NOLINT
+TEMPLATE_TEST_CASE_METHOD(IndexerFixture, "Get and return one index multiple times", "[indexer]", MutexIndexer, ConcurrentIndexer, ConcurrentMagazineIndexer, SmallMutexMagazineIndexer, WaitableMutexIndexer, WaitableConcurrentIndexer, MutexIndexerWithStats, ConcurrentIndexerWithStats, StackIndexer, StackIndexerWithStats, BitmapIndexer, BitmapIndexerWithStats, ConcurrentRseqIndexer, SmallMutexRseqIndexer, SpinLockIndexer, TicketLockIndexer, AdaptiveLockIndexer, TicketLockIndexerWithStats, RingIndexer, RingIndexerWithStats) {  // NOLINT
     IndexerFixture<TestType>::GetAndReturnOneIndexMultipleTimes();
 }
 
 
-TEMPLATE_TEST_CASE_METHOD(IndexerFixture, "Get and return various indices", "[indexer]", MutexIndexer, ConcurrentIndexer) {  // NOLINT
+TEMPLATE_TEST_CASE_METHOD(IndexerFixture, "Get and return various indices", "[indexer]", MutexIndexer, ConcurrentIndexer, ConcurrentMagazineIndexer, SmallMutexMagazineIndexer, WaitableMutexIndexer, WaitableConcurrentIndexer, MutexIndexerWithStats, ConcurrentIndexerWithStats, StackIndexer, StackIndexerWithStats, BitmapIndexer, BitmapIndexerWithStats, ConcurrentRseqIndexer, SmallMutexRseqIndexer, SpinLockIndexer, TicketLockIndexer, AdaptiveLockIndexer, TicketLockIndexerWithStats, RingIndexer, RingIndexerWithStats) {  // NOLINT
     IndexerFixture<TestType>::GetAndreturnVariousIndices();
 }
 
-TEMPLATE_TEST_CASE_METHOD(IndexerFixture, "Get index, no more indices", "[indexer]", MutexIndexer, ConcurrentIndexer) {  // NOLINT
+TEMPLATE_TEST_CASE_METHOD(IndexerFixture, "Get index, no more indices", "[indexer]", MutexIndexer, ConcurrentIndexer, ConcurrentMagazineIndexer, SmallMutexMagazineIndexer, WaitableMutexIndexer, WaitableConcurrentIndexer, MutexIndexerWithStats, ConcurrentIndexerWithStats, StackIndexer, StackIndexerWithStats, BitmapIndexer, BitmapIndexerWithStats, ConcurrentRseqIndexer, SmallMutexRseqIndexer, SpinLockIndexer, TicketLockIndexer, AdaptiveLockIndexer, TicketLockIndexerWithStats, RingIndexer, RingIndexerWithStats) {  // NOLINT
     IndexerFixture<TestType>::GetIndexNoMoreIndices();
 }
 
-TEMPLATE_TEST_CASE_METHOD(IndexerFixture, "Get all indices multithreaded", "[indexer]", MutexIndexer, ConcurrentIndexer) {  // NOLINT
+TEMPLATE_TEST_CASE_METHOD(IndexerFixture, "Get all indices multithreaded", "[indexer]", MutexIndexer, ConcurrentIndexer, ConcurrentMagazineIndexer, SmallMutexMagazineIndexer, WaitableMutexIndexer, WaitableConcurrentIndexer, MutexIndexerWithStats, ConcurrentIndexerWithStats, StackIndexer, StackIndexerWithStats, BitmapIndexer, BitmapIndexerWithStats, ConcurrentRseqIndexer, SmallMutexRseqIndexer, SpinLockIndexer, TicketLockIndexer, AdaptiveLockIndexer, TicketLockIndexerWithStats, RingIndexer, RingIndexerWithStats) {  // NOLINT
     IndexerFixture<TestType>::GetIndicesMultiThreaded();
 }
 
-TEMPLATE_TEST_CASE_METHOD(IndexerFixture, "Get and return indices multithreaded", "[indexer]", MutexIndexer, ConcurrentIndexer) {  // NOLINT
+TEMPLATE_TEST_CASE_METHOD(IndexerFixture, "Get and return indices multithreaded", "[indexer]", MutexIndexer, ConcurrentIndexer, ConcurrentMagazineIndexer, SmallMutexMagazineIndexer, WaitableMutexIndexer, WaitableConcurrentIndexer, MutexIndexerWithStats, ConcurrentIndexerWithStats, StackIndexer, StackIndexerWithStats, BitmapIndexer, BitmapIndexerWithStats, ConcurrentRseqIndexer, SmallMutexRseqIndexer, SpinLockIndexer, TicketLockIndexer, AdaptiveLockIndexer, TicketLockIndexerWithStats, RingIndexer, RingIndexerWithStats) {  // NOLINT
     IndexerFixture<TestType>::GetAndReturnIndicesMultiThreaded();
 }
 
-TEMPLATE_TEST_CASE_METHOD(IndexerFixture, "Get and return indices more threads than items", "[indexer]", MutexIndexer, ConcurrentIndexer) {  // NOLINT
+TEMPLATE_TEST_CASE_METHOD(IndexerFixture, "Get and return indices more threads than items", "[indexer]", MutexIndexer, ConcurrentIndexer, ConcurrentMagazineIndexer, SmallMutexMagazineIndexer, WaitableMutexIndexer, WaitableConcurrentIndexer, MutexIndexerWithStats, ConcurrentIndexerWithStats, StackIndexer, StackIndexerWithStats, BitmapIndexer, BitmapIndexerWithStats, ConcurrentRseqIndexer, SmallMutexRseqIndexer, SpinLockIndexer, TicketLockIndexer, AdaptiveLockIndexer, TicketLockIndexerWithStats, RingIndexer, RingIndexerWithStats) {  // NOLINT
     IndexerFixture<TestType>::GetAndReturnIndicesMoreThreadsThanItems();
-}
\ No newline at end of file
+}
+
+TEMPLATE_TEST_CASE_METHOD(IndexerFixture, "Get all indices in batches", "[indexer]", MutexIndexer, ConcurrentIndexer, ConcurrentMagazineIndexer, SmallMutexMagazineIndexer, WaitableMutexIndexer, WaitableConcurrentIndexer, MutexIndexerWithStats, ConcurrentIndexerWithStats, StackIndexer, StackIndexerWithStats, BitmapIndexer, BitmapIndexerWithStats, ConcurrentRseqIndexer, SmallMutexRseqIndexer, SpinLockIndexer, TicketLockIndexer, AdaptiveLockIndexer, TicketLockIndexerWithStats, RingIndexer, RingIndexerWithStats) {  // NOLINT
+    IndexerFixture<TestType>::GetAllIndicesInBatches();
+}
+
+TEMPLATE_TEST_CASE_METHOD(IndexerFixture, "Get and return a batch of indices", "[indexer]", MutexIndexer, ConcurrentIndexer, ConcurrentMagazineIndexer, SmallMutexMagazineIndexer, WaitableMutexIndexer, WaitableConcurrentIndexer, MutexIndexerWithStats, ConcurrentIndexerWithStats, StackIndexer, StackIndexerWithStats, BitmapIndexer, BitmapIndexerWithStats, ConcurrentRseqIndexer, SmallMutexRseqIndexer, SpinLockIndexer, TicketLockIndexer, AdaptiveLockIndexer, TicketLockIndexerWithStats, RingIndexer, RingIndexerWithStats) {  // NOLINT
+    IndexerFixture<TestType>::GetAndReturnBatch();
+}
+
+TEMPLATE_TEST_CASE_METHOD(IndexerFixture, "Get and return batches of indices multithreaded", "[indexer]", MutexIndexer, ConcurrentIndexer, ConcurrentMagazineIndexer, SmallMutexMagazineIndexer, WaitableMutexIndexer, WaitableConcurrentIndexer, MutexIndexerWithStats, ConcurrentIndexerWithStats, StackIndexer, StackIndexerWithStats, BitmapIndexer, BitmapIndexerWithStats, ConcurrentRseqIndexer, SmallMutexRseqIndexer, SpinLockIndexer, TicketLockIndexer, AdaptiveLockIndexer, TicketLockIndexerWithStats, RingIndexer, RingIndexerWithStats) {  // NOLINT
+    IndexerFixture<TestType>::GetAndReturnBatchesMultiThreaded();
+}
@@ -0,0 +1,118 @@
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <type_traits>
+#include <vector>
+
+#include "../src/ConcurrentIndexer.h"
+#include "../src/MutexIndexer.h"
+#include "../src/Pool.h"
+#include "../src/ResetPolicies.h"
+#include "TestTypes.h"
+
+using namespace dxpool;
+using namespace std;
+
+namespace {
+
+struct ZeroInt {
+    inline auto operator()(int* item) const -> void {
+        *item = 0;
+    }
+};
+
+class SetTo {
+  private:
+    int value{0};
+
+  public:
+    SetTo() = default;
+    explicit SetTo(int resetValue): value(resetValue) {}
+
+    inline auto operator()(int* item) const -> void {
+        *item = this->value;
+    }
+};
+
+} // namespace
+
+static_assert(std::is_same<StaticPool<int, 3>, BasicPool<int, CallbackReset<int>, std::array<int, 3>, MutexIndexer>>::value, "static pool alias");
+static_assert(std::is_same<RuntimePool<ResetableCopyMoveObject<>, ConcurrentIndexer>,
+              BasicPool<ResetableCopyMoveObject<>, MemberReset, std::vector<ResetableCopyMoveObject<>>, ConcurrentIndexer>>::value, "runtime pool alias");
+static_assert(std::is_same<DefaultReset<ResetableNoCopyMoveObject>, MemberReset>::value, "resetable types use their Reset()");
+static_assert(sizeof(BasicPool<int, NoReset>) < sizeof(RuntimePool<int>), "no reset callback stored with NoReset");
+
+TEST_CASE("Policy based pool", "[pool][basicpool]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("No reset leaves items as they are") {
+        BasicPool<ResetableNoCopyMoveObject, NoReset, std::array<ResetableNoCopyMoveObject, 1>> pool;
+        ResetableNoCopyMoveObject* obj = nullptr;
+        {
+            auto item = pool.TakeHandle();
+            obj = item.Get();
+        }
+
+        REQUIRE_FALSE(obj->WasReset());
+        REQUIRE(obj->Value() == ResetableNoCopyMoveObject::DefaultNonCopiableObjectValue);
+    }
+
+    SECTION("Reset functor type") {
+        BasicPool<int, ZeroInt> pool(2);
+        REQUIRE(pool.Size() == 2);
+
+        int* value = nullptr;
+        {
+            auto item = pool.Take();
+            value = item.Get();
+            *value = 1;
+        }
+
+        REQUIRE(*value == 0);
+    }
+
+    SECTION("Reset functor instance") {
+        const int resetValue = 13;
+        BasicPool<int, SetTo, std::vector<int>, ConcurrentIndexer> pool(1, SetTo(resetValue));
+
+        int* value = nullptr;
+        {
+            auto item = pool.TakeShared();
+            value = item.Get();
+        }
+
+        REQUIRE(*value == resetValue);
+    }
+
+    SECTION("Member reset") {
+        BasicPool<ResetableCopyMoveObject<>, MemberReset> pool(1);
+        ResetableCopyMoveObject<>* obj = nullptr;
+        {
+            auto item = pool.TakeHandle();
+            obj = item.Get();
+        }
+
+        REQUIRE(obj->WasReset());
+    }
+
+    SECTION("Callback reset") {
+        const int resetValue = 21;
+        BasicPool<int> pool(1, [](int* item) {
+            *item = resetValue;
+        });
+
+        int* value = nullptr;
+        {
+            auto item = pool.TakeHandle();
+            value = item.Get();
+        }
+
+        REQUIRE(*value == resetValue);
+    }
+
+    SECTION("Static size taken from the storage") {
+        BasicPool<int, NoReset, std::array<int, 4>, ConcurrentIndexer> pool;
+        REQUIRE(pool.Size() == 4);
+
+        vector<decltype(pool)::Handle> handles;
+        REQUIRE(pool.TakeBatch(5, handles) == 4);
+    }
+}
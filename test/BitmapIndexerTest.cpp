@@ -0,0 +1,140 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "../src/BitmapIndexer.h"
+#include "../src/Pool.h"
+
+using namespace dxpool;
+using namespace std;
+
+TEST_CASE("Bitmap indexer", "[indexer][bitmap]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("The lowest free index is taken first") {
+        BitmapIndexer indexer(8);
+        for(size_t i = 0 ; i < 4 ; i++) {
+            REQUIRE(indexer.Next().Get() == i);
+        }
+
+        indexer.Return(2);
+        indexer.Return(1);
+        REQUIRE(indexer.Next().Get() == 1);
+        REQUIRE(indexer.Next().Get() == 2);
+        REQUIRE(indexer.Next().Get() == 4);
+    }
+
+    SECTION("Full words are skipped") {
+        const size_t maxSize = 1000;
+        BitmapIndexer indexer(maxSize);
+        vector<size_t> batch(maxSize);
+        REQUIRE(indexer.Next(900, batch.data()) == 900);
+        for(size_t i = 0 ; i < 900 ; i++) {
+            REQUIRE(batch[i] == i);
+        }
+
+        REQUIRE(indexer.Next().Get() == 900);
+
+        indexer.Return(700);
+        indexer.Return(650);
+        REQUIRE(indexer.Next().Get() == 650);
+        REQUIRE(indexer.Next().Get() == 700);
+        REQUIRE(indexer.Next().Get() == 901);
+    }
+
+    SECTION("Batches span several words") {
+        BitmapIndexer indexer(200);
+        vector<size_t> batch(150);
+        REQUIRE(indexer.Next(150, batch.data()) == 150);
+        REQUIRE(batch.back() == 149);
+
+        // indices of different words, not sorted
+        vector<size_t> returned{130, 3, 4, 70, 2};
+        indexer.Return(returned.data(), returned.size());
+
+        REQUIRE(indexer.Next(4, batch.data()) == 4);
+        REQUIRE(vector<size_t>(batch.begin(), batch.begin() + 4) == vector<size_t>{2, 3, 4, 70});
+        REQUIRE(indexer.Next().Get() == 130);
+        REQUIRE(indexer.Next().Get() == 150);
+    }
+
+    SECTION("Indices past the pool size are never taken") {
+        BitmapIndexer indexer(65);
+        vector<size_t> batch(128);
+        REQUIRE(indexer.Next(128, batch.data()) == 65);
+        REQUIRE(batch[64] == 64);
+        REQUIRE(indexer.Next().Empty());
+    }
+
+    SECTION("Statistics") {
+        BasicBitmapIndexer<ShardedStats> indexer(4);
+        vector<size_t> batch(4);
+        REQUIRE(indexer.Next(4, batch.data()) == 4);
+        REQUIRE(indexer.Next().Empty());
+        indexer.Return(batch.data(), 2);
+        indexer.Return(batch[2]);
+
+        const auto stats = indexer.Stats();
+        REQUIRE(stats.taken == 4);
+        REQUIRE(stats.returned == 3);
+        REQUIRE(stats.takeFailures == 1);
+        REQUIRE(stats.highWatermark == 4);
+    }
+
+    SECTION("Indices are not handed out twice while threads take and return indices of the same word") {
+        constexpr const size_t threadCount = 8;
+        constexpr const int iterations = 5000;
+        constexpr const size_t maxSize = 6;
+        BitmapIndexer indexer(maxSize);
+
+        vector<atomic<int>> owners(maxSize);
+        atomic<bool> shared{false};
+        vector<thread> threads;
+        for(size_t t = 0 ; t < threadCount ; t++) {
+            threads.emplace_back([&indexer, &owners, &shared]() {
+                vector<size_t> batch(2);
+                for(int n = 0 ; n < iterations ; n++) {
+                    const size_t taken = indexer.Next(2, batch.data());
+                    for(size_t i = 0 ; i < taken ; i++) {
+                        if(owners[batch[i]].fetch_add(1) != 0) {
+                            shared = true;
+                        }
+                    }
+
+                    this_thread::yield();
+                    for(size_t i = 0 ; i < taken ; i++) {
+                        owners[batch[i]].fetch_sub(1);
+                    }
+                    indexer.Return(batch.data(), taken);
+                }
+            });
+        }
+
+        for(auto& thread: threads) {
+            thread.join();
+        }
+
+        REQUIRE_FALSE(shared);
+
+        set<size_t> indices;
+        for(auto result = indexer.Next() ; !result.Empty(); result = indexer.Next()) {
+            indices.insert(result.Get());
+        }
+
+        REQUIRE(indices.size() == maxSize);
+    }
+}
+
+TEST_CASE("Pool with a bitmap indexer", "[pool][indexer][bitmap]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("Items in use are packed at the front of the pool") {
+        RuntimePool<int, BitmapIndexer> pool(1024);
+        vector<RuntimePool<int, BitmapIndexer>::Handle> handles;
+        REQUIRE(pool.TakeBatch(16, handles) == 16);
+
+        handles.resize(4);
+        auto handle = pool.TakeHandle();
+        REQUIRE(handle.PoolIndex() == 4);
+    }
+}
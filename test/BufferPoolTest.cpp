@@ -0,0 +1,126 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "../src/BufferPool.h"
+#include "../src/ConcurrentIndexer.h"
+#include "../src/MutexIndexer.h"
+
+using namespace dxpool;
+using namespace std;
+
+TEST_CASE("Buffer pool", "[bufferpool]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("Buffers are taken from the smallest class that fits") {
+        BufferPool<> pool{{256, 2}, {64, 2}, {1024, 1}};
+        REQUIRE(pool.SizeClassCount() == 3);
+        REQUIRE(pool.MaxBufferSize() == 1024);
+
+        auto small = pool.Take(10);
+        REQUIRE_FALSE(small.Empty());
+        REQUIRE(small.Size() == 10);
+        REQUIRE(small.Capacity() == 64);
+
+        auto medium = pool.Take(65);
+        REQUIRE(medium.Capacity() == 256);
+
+        auto large = pool.Take(1024);
+        REQUIRE(large.Capacity() == 1024);
+        REQUIRE(large.end() - large.begin() == 1024);
+    }
+
+    SECTION("Larger classes are used once a class runs out") {
+        BufferPool<MutexIndexer> pool{{32, 1}, {128, 1}};
+
+        auto first = pool.Take(16);
+        auto second = pool.Take(16);
+        auto third = pool.Take(16);
+
+        REQUIRE(first.Capacity() == 32);
+        REQUIRE(second.Capacity() == 128);
+        REQUIRE(third.Empty());
+        REQUIRE(third.Data() == nullptr);
+        REQUIRE(third.Capacity() == 0);
+    }
+
+    SECTION("Requests larger than the largest class are empty") {
+        BufferPool<> pool{{64, 4}};
+        REQUIRE(pool.Take(65).Empty());
+    }
+
+    SECTION("Buffers are returned when destroyed") {
+        BufferPool<> pool{{64, 1}};
+        unsigned char* data = nullptr;
+        {
+            auto buffer = pool.Take(8);
+            data = buffer.Data();
+            std::memset(buffer.Data(), 1, buffer.Size());
+            REQUIRE(pool.Take(8).Empty());
+        }
+
+        auto buffer = pool.Take(64);
+        REQUIRE(buffer.Data() == data);
+    }
+
+    SECTION("Moved buffers are empty") {
+        BufferPool<> pool{{64, 1}};
+        auto buffer = pool.Take(8);
+        auto moved = std::move(buffer);
+
+        REQUIRE(buffer.Empty()); // NOLINT(bugprone-use-after-move, hicpp-invalid-access-moved)
+        REQUIRE(buffer.Size() == 0); // NOLINT(bugprone-use-after-move, hicpp-invalid-access-moved)
+        REQUIRE(moved.Size() == 8);
+    }
+
+    SECTION("Buffers are aligned") {
+        BufferPool<> pool{{24, 4}};
+        auto buffer = pool.Take(24);
+        auto other = pool.Take(24);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(buffer.Data()) % alignof(std::max_align_t) == 0); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        REQUIRE(reinterpret_cast<std::uintptr_t>(other.Data()) % alignof(std::max_align_t) == 0); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+
+    SECTION("Invalid size classes") {
+        REQUIRE_THROWS_AS(BufferPool<>(vector<BufferSizeClass>{}), InvalidBufferPoolArgumentsError);
+        REQUIRE_THROWS_AS(BufferPool<>({{0, 1}}), InvalidBufferPoolArgumentsError);
+        REQUIRE_THROWS_AS(BufferPool<>({{64, 0}}), InvalidBufferPoolArgumentsError);
+    }
+
+    SECTION("Buffers taken from many threads are not shared") {
+        constexpr const size_t threadCount = 8;
+        constexpr const int iterations = 500;
+        BufferPool<> pool{{64, 8}, {512, 8}};
+
+        atomic<int> sharedBuffers{0};
+        vector<thread> threads;
+        for(size_t t = 0 ; t < threadCount ; t++) {
+            threads.emplace_back([&pool, &sharedBuffers, t]() {
+                const auto mark = static_cast<unsigned char>(t + 1);
+                for(int n = 0 ; n < iterations ; n++) {
+                    auto buffer = pool.Take(static_cast<size_t>(n % 300) + 1);
+                    if(buffer.Empty()) {
+                        continue;
+                    }
+
+                    std::memset(buffer.Data(), mark, buffer.Size());
+                    std::this_thread::yield();
+                    for(auto byte: buffer) {
+                        if(byte != mark) {
+                            sharedBuffers++;
+                            break;
+                        }
+                    }
+                }
+            });
+        }
+
+        for(auto& thread: threads) {
+            thread.join();
+        }
+
+        REQUIRE(sharedBuffers.load() == 0);
+    }
+}
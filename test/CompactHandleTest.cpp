@@ -0,0 +1,122 @@
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "../src/CompactHandle.h"
+#include "../src/ConcurrentIndexer.h"
+#include "../src/MutexIndexer.h"
+#include "../src/Pool.h"
+#include "TestTypes.h"
+
+using namespace dxpool;
+using namespace std;
+
+static_assert(std::is_trivially_copyable<CompactHandle>::value, "compact handles can be copied as plain values");
+
+template<typename ItemType, std::size_t Size>
+using StaticGenerationPool = Pool<ItemType, array<ItemType, Size>, MutexIndexer, Size, NoStats, ResetOnReturn, NoOccupancy, SlotGenerations>;
+
+template<typename ItemType, typename Indexer = MutexIndexer>
+using RuntimeGenerationPool = Pool<ItemType, vector<ItemType>, Indexer, 0, NoStats, ResetOnReturn, NoOccupancy, SlotGenerations>;
+
+TEST_CASE("Compact handle", "[compacthandle]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("Index and generation are packed in a 64 bit value") {
+        const CompactHandle handle(3, 7);
+        REQUIRE(handle.PoolIndex() == 3);
+        REQUIRE(handle.Generation() == 7);
+        REQUIRE_FALSE(handle.Empty());
+        REQUIRE(handle.Value() == ((static_cast<uint64_t>(7) << 32U) | 3U));
+
+        const auto copy = CompactHandle::FromValue(handle.Value());
+        REQUIRE(copy == handle);
+        REQUIRE(copy != CompactHandle(3, 8));
+    }
+
+    SECTION("Default handle is empty") {
+        const CompactHandle handle;
+        REQUIRE(handle.Empty());
+    }
+
+    SECTION("Slot generations reject pools whose indices don't fit in 32 bits") {
+        REQUIRE_THROWS_AS(SlotGenerations(static_cast<size_t>(0x100000000ULL)), InvalidCompactHandleArgumentsError);
+    }
+}
+
+TEST_CASE("Resolve compact handles", "[pool][compacthandle]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("Handle resolves while the item is taken") {
+        StaticGenerationPool<int, 2> pool;
+        auto item = pool.TakeHandle();
+        const auto handle = pool.MakeCompactHandle(item.PoolIndex());
+
+        REQUIRE(pool.Resolve(handle) == item.Get());
+        REQUIRE(pool.Resolve(handle) == item.Get());
+    }
+
+    SECTION("Handle is stale once the item is returned") {
+        RuntimeGenerationPool<int, ConcurrentIndexer> pool(1);
+        CompactHandle handle;
+        {
+            auto item = pool.Take();
+            handle = pool.MakeCompactHandle(item.PoolIndex());
+        }
+
+        REQUIRE(pool.Resolve(handle) == nullptr);
+
+        auto item = pool.TakeHandle();
+        REQUIRE(item.PoolIndex() == handle.PoolIndex());
+        REQUIRE(pool.Resolve(handle) == nullptr);
+
+        const auto newHandle = pool.MakeCompactHandle(item.PoolIndex());
+        REQUIRE(newHandle.Generation() != handle.Generation());
+        REQUIRE(pool.Resolve(newHandle) == item.Get());
+    }
+
+    SECTION("Handles of shared items are stale once the last copy is released") {
+        RuntimeGenerationPool<ResetableCopyMoveObject<>> pool(1);
+        CompactHandle handle;
+        {
+            decltype(pool)::SharedItem copy;
+            {
+                auto item = pool.TakeShared();
+                handle = pool.MakeCompactHandle(item.PoolIndex());
+                copy = item;
+            }
+
+            REQUIRE(pool.Resolve(handle) == copy.Get());
+        }
+
+        REQUIRE(pool.Resolve(handle) == nullptr);
+    }
+
+    SECTION("Handles of items returned in a batch are stale") {
+        RuntimeGenerationPool<int> pool(4);
+        vector<decltype(pool)::Handle> handles;
+        REQUIRE(pool.TakeBatch(4, handles) == 4);
+
+        vector<CompactHandle> compactHandles;
+        for(auto& handle: handles) {
+            compactHandles.push_back(pool.MakeCompactHandle(handle.PoolIndex()));
+            REQUIRE(pool.Resolve(compactHandles.back()) == handle.Get());
+        }
+
+        pool.ReturnBatch(handles);
+        for(const auto& handle: compactHandles) {
+            REQUIRE(pool.Resolve(handle) == nullptr);
+        }
+    }
+
+    SECTION("Empty, foreign and out of range handles don't resolve") {
+        StaticGenerationPool<int, 2> pool;
+        REQUIRE(pool.Resolve(CompactHandle()) == nullptr);
+
+        auto item = pool.TakeHandle();
+        const auto handle = pool.MakeCompactHandle(item.PoolIndex());
+        REQUIRE(pool.Resolve(CompactHandle(2, handle.Generation())) == nullptr);
+        REQUIRE(pool.Resolve(CompactHandle(static_cast<uint32_t>(handle.PoolIndex()), handle.Generation() + 1)) == nullptr);
+    }
+}
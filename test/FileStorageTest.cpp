@@ -0,0 +1,171 @@
+#include <catch2/catch_test_macros.hpp>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../src/ConcurrentIndexer.h"
+#include "../src/FileStorage.h"
+#include "../src/MutexIndexer.h"
+
+using namespace dxpool;
+using namespace std;
+
+namespace {
+
+struct Session {
+    std::uint64_t id;
+    std::int64_t deadline;
+};
+
+/**
+ * @brief Creates an empty temporary file, removed when destroyed
+ *
+ */
+class TemporaryFile final {
+  private:
+    string path;
+
+  public:
+    TemporaryFile() {
+        string pathTemplate = "/tmp/dxpool-file-storage-XXXXXX";
+        const int fd = mkstemp(&pathTemplate[0]);
+        if(fd >= 0) {
+            close(fd);
+        }
+        this->path = pathTemplate;
+    }
+
+    auto Path() const -> const string& {
+        return this->path;
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(TemporaryFile);
+
+    ~TemporaryFile() {
+        unlink(this->path.c_str());
+    }
+};
+
+} // namespace
+
+TEST_CASE("File storage", "[storage][file]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("New file has default constructed items") {
+        TemporaryFile file;
+        FileStorage<Session> storage(4, file.Path());
+
+        REQUIRE(storage.Created());
+        REQUIRE(storage.size() == 4);
+        REQUIRE(storage.RestoredIndices().empty());
+        for(IndexSizeT i = 0 ; i < storage.size() ; i++) {
+            REQUIRE(storage[i].id == 0);
+            REQUIRE_FALSE(storage.InUse(i));
+        }
+    }
+
+    SECTION("Items and in use flags are kept in the file") {
+        TemporaryFile file;
+        {
+            FileStorage<Session> storage(3, file.Path());
+            storage[1] = Session{7, 70};
+            storage.Acquire(1);
+            storage.Acquire(2);
+            storage.Release(2);
+        }
+
+        FileStorage<Session> storage(3, file.Path());
+        REQUIRE_FALSE(storage.Created());
+        REQUIRE(storage[1].id == 7);
+        REQUIRE(storage[1].deadline == 70);
+        REQUIRE(storage.RestoredIndices() == vector<IndexSizeT>{1});
+
+        storage.ClearRestored();
+        REQUIRE(storage.RestoredIndices().empty());
+    }
+
+    SECTION("Files with a different layout are not attached") {
+        TemporaryFile file;
+        {
+            FileStorage<Session> storage(3, file.Path());
+        }
+
+        REQUIRE_THROWS_AS(FileStorage<Session>(4, file.Path()), FileStorageError);
+        REQUIRE_THROWS_AS(FileStorage<std::uint64_t>(3, file.Path()), FileStorageError);
+    }
+
+    SECTION("Invalid path") {
+        REQUIRE_THROWS_AS(FileStorage<Session>(1, "/nonexistent-directory/pool"), FileStorageError);
+    }
+}
+
+TEST_CASE("File backed pool", "[pool][storage][file]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("Returned items are free and keep their contents in a new pool") {
+        TemporaryFile file;
+        {
+            FilePool<Session> pool(2, file.Path());
+            auto item = pool.Take();
+            item.Get()->id = 42;
+        }
+
+        FilePool<Session> pool(2, file.Path());
+        vector<FilePool<Session>::Handle> handles;
+        REQUIRE(pool.TakeRestored(handles) == 0);
+        REQUIRE(pool.TakeBatch(2, handles) == 2);
+        REQUIRE((handles[0].Get()->id == 42 || handles[1].Get()->id == 42));
+    }
+
+    SECTION("Pool re-mapped after a process exit restores the items in use and the free indices") {
+        constexpr const IndexSizeT poolSize = 8;
+        TemporaryFile file;
+
+        const pid_t child = fork();
+        if(child == 0) {
+            // exits without destructors, as a process being restarted, with items still taken
+            FilePool<Session, ConcurrentIndexer> pool(poolSize, file.Path());
+            vector<FilePool<Session, ConcurrentIndexer>::Handle> handles;
+            pool.TakeBatch(5, handles);
+            for(auto& handle: handles) {
+                handle.Get()->id = 100 + handle.PoolIndex();
+                handle.Get()->deadline = 1;
+            }
+
+            handles.resize(3);
+            _exit(0);
+        }
+
+        int status = 0;
+        REQUIRE(waitpid(child, &status, 0) == child);
+        REQUIRE(WIFEXITED(status));
+
+        FilePool<Session, ConcurrentIndexer> pool(poolSize, file.Path());
+
+        vector<FilePool<Session, ConcurrentIndexer>::Handle> restored;
+        REQUIRE(pool.TakeRestored(restored) == 3);
+        set<IndexSizeT> restoredIndices;
+        for(auto& handle: restored) {
+            REQUIRE(handle.Get()->id == 100 + handle.PoolIndex());
+            REQUIRE(handle.Get()->deadline == 1);
+            restoredIndices.insert(handle.PoolIndex());
+        }
+
+        // restored items are only handed out once
+        vector<FilePool<Session, ConcurrentIndexer>::Handle> handles;
+        REQUIRE(pool.TakeRestored(handles) == 0);
+
+        // only the free indices are left in the pool
+        REQUIRE(pool.TakeBatch(poolSize, handles) == poolSize - 3);
+        for(auto& handle: handles) {
+            REQUIRE(restoredIndices.count(handle.PoolIndex()) == 0);
+        }
+
+        handles.clear();
+        restored.clear();
+        REQUIRE(pool.TakeBatch(poolSize, handles) == poolSize);
+    }
+}
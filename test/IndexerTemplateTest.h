@@ -212,6 +212,96 @@ class IndexerFixture {
         REQUIRE(indices.empty());
     }
 
+    // Get all indices in batches, including a partial last batch
+    static auto GetAllIndicesInBatches() -> void {
+        const size_t maxSize = 37;
+        const size_t batchSize = 8;
+        set<size_t> indices;
+        vector<size_t> batch(batchSize);
+
+        Indexer indexer(maxSize);
+
+        size_t taken = indexer.Next(batchSize, batch.data());
+        while(taken > 0) {
+            indices.insert(batch.begin(), batch.begin() + static_cast<ptrdiff_t>(taken));
+            taken = indexer.Next(batchSize, batch.data());
+        }
+
+        REQUIRE(indexer.Next().Empty());
+        REQUIRE(indices.size() == maxSize);
+        REQUIRE(*indices.rbegin() == maxSize - 1);
+    }
+
+    // Return a batch of indices and get them back
+    static auto GetAndReturnBatch() -> void {
+        const size_t maxSize = 19;
+        const int iterations = 11;
+        vector<size_t> batch(maxSize);
+
+        Indexer indexer(maxSize);
+
+        for(int i = 0 ; i < iterations ; i++) {
+            REQUIRE(indexer.Next(maxSize, batch.data()) == maxSize);
+            REQUIRE(indexer.Next().Empty());
+
+            indexer.Return(batch.data(), maxSize);
+        }
+
+        // returned indices are available to both single and batch calls
+        auto single = indexer.Next();
+        REQUIRE_FALSE(single.Empty());
+        REQUIRE(indexer.Next(maxSize, batch.data()) == maxSize - 1);
+
+        batch[maxSize - 1] = single.Get();
+        set<size_t> indices(batch.begin(), batch.end());
+        REQUIRE(indices.size() == maxSize);
+    }
+
+    // Get and return batches of indices with multiple threads
+    static auto GetAndReturnBatchesMultiThreaded() -> void {
+        const int threadCount  = 12;
+        const size_t maxSize = 97;
+        const size_t batchSize = 7;
+        const int iterations = 500;
+
+        Indexer indexer(maxSize);
+        list<thread> threads;
+        atomic<bool> failed{false};
+
+        auto batchFn = [&]() -> void {
+            vector<size_t> batch(batchSize);
+            for(int i = 0 ; i < iterations ; i++) {
+                const size_t taken = indexer.Next(batchSize, batch.data());
+                for(size_t pos = 0 ; pos < taken ; pos++) {
+                    if(batch[pos] >= maxSize) {
+                        failed = true;
+                    }
+                }
+                this_thread::yield();
+                indexer.Return(batch.data(), taken);
+            }
+        };
+
+        for(int i = 0; i < threadCount; ++i) {
+            threads.emplace_back(batchFn);
+        }
+
+        for(auto& indexerThread : threads) {
+            indexerThread.join();
+        }
+
+        REQUIRE_FALSE(failed);
+
+        // all indices must be available once all threads returned them
+        set<size_t> indices;
+        for(auto result = indexer.Next() ; !result.Empty(); result = indexer.Next()) {
+            indices.insert(result.Get());
+        }
+
+        REQUIRE(indices.size() == maxSize);
+        REQUIRE(*indices.rbegin() == maxSize - 1);
+    }
+
     // Get and return indices with multiple threads
     static auto GetAndReturnIndicesMultiThreaded() -> void {
         const int threadCount  = 22;
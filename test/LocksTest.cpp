@@ -0,0 +1,65 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../src/Locks.h"
+#include "../src/MutexIndexer.h"
+
+using namespace dxpool;
+using namespace std;
+
+TEMPLATE_TEST_CASE("Locks", "[locks]", TTASSpinLock, TicketLock, AdaptiveLock) { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("Try lock fails while the lock is held") {
+        TestType lock;
+        REQUIRE(lock.try_lock());
+        REQUIRE_FALSE(lock.try_lock());
+        lock.unlock();
+
+        unique_lock<TestType> guard(lock);
+        REQUIRE_FALSE(lock.try_lock());
+    }
+
+    SECTION("Threads increment a counter under the lock") {
+        constexpr const int threadCount = 8;
+        constexpr const int iterations = 20000;
+        TestType lock;
+        int counter = 0;
+        atomic<int> inside{0};
+        atomic<bool> overlapped{false};
+
+        vector<thread> threads;
+        for(int t = 0 ; t < threadCount ; t++) {
+            threads.emplace_back([&lock, &counter, &inside, &overlapped]() {
+                for(int n = 0 ; n < iterations ; n++) {
+                    lock_guard<TestType> guard(lock);
+                    if(inside.fetch_add(1) != 0) {
+                        overlapped = true;
+                    }
+                    counter++;
+                    inside.fetch_sub(1);
+                }
+            });
+        }
+
+        for(auto& thread: threads) {
+            thread.join();
+        }
+
+        REQUIRE_FALSE(overlapped);
+        REQUIRE(counter == threadCount * iterations);
+    }
+}
+
+TEST_CASE("Mutex indexer lock policies", "[indexer][locks]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("Contention is counted with any lock policy") {
+        BasicMutexIndexer<ShardedStats, AdaptiveLock> indexer(2);
+        REQUIRE(indexer.Next().Get() == 0);
+        REQUIRE(indexer.Stats().taken == 1);
+        REQUIRE(indexer.Stats().lockContentions == 0);
+    }
+}
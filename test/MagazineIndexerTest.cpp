@@ -0,0 +1,145 @@
+#include <catch2/catch_test_macros.hpp>
+#include <condition_variable>
+#include <new>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "../src/MagazineIndexer.h"
+#include "../src/MutexIndexer.h"
+#include "../src/ConcurrentIndexer.h"
+#include "../src/Pool.h"
+
+using namespace dxpool;
+using namespace std;
+
+TEST_CASE("Magazine indexer", "[indexer][magazine]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+    constexpr const IndexSizeT magazineCapacity = 8;
+
+    SECTION("Indices cached by a thread are drained when the thread exits") {
+        const size_t maxSize = 20;
+        MagazineIndexer<ConcurrentIndexer, magazineCapacity> indexer(maxSize);
+
+        thread worker([&indexer]() {
+            vector<size_t> taken;
+            for(auto result = indexer.Next(); !result.Empty(); result = indexer.Next()) {
+                taken.push_back(result.Get());
+            }
+
+            // returned indices stay in this thread's magazine, up to its capacity
+            for(const auto index: taken) {
+                indexer.Return(index);
+            }
+        });
+        worker.join();
+
+        set<size_t> indices;
+        for(auto result = indexer.Next(); !result.Empty(); result = indexer.Next()) {
+            indices.insert(result.Get());
+        }
+
+        REQUIRE(indices.size() == maxSize);
+    }
+
+    SECTION("Cached indices are not visible to other threads until flushed") {
+        const size_t maxSize = 4;
+        MagazineIndexer<MutexIndexer, magazineCapacity> indexer(maxSize);
+
+        vector<size_t> taken;
+        for(auto result = indexer.Next(); !result.Empty(); result = indexer.Next()) {
+            taken.push_back(result.Get());
+        }
+        REQUIRE(taken.size() == maxSize);
+
+        for(const auto index: taken) {
+            indexer.Return(index);
+        }
+
+        bool otherThreadEmpty = false;
+        thread([&indexer, &otherThreadEmpty]() {
+            otherThreadEmpty = indexer.Next().Empty();
+        }).join();
+        REQUIRE(otherThreadEmpty);
+
+        indexer.Flush();
+
+        size_t otherThreadCount = 0;
+        thread([&indexer, &otherThreadCount]() {
+            for(auto result = indexer.Next(); !result.Empty(); result = indexer.Next()) {
+                otherThreadCount++;
+            }
+        }).join();
+        REQUIRE(otherThreadCount == maxSize);
+    }
+
+    SECTION("Full magazines are flushed to the shared indexer") {
+        const size_t maxSize = 30;
+        MagazineIndexer<ConcurrentIndexer, magazineCapacity> indexer(maxSize);
+
+        vector<size_t> taken(maxSize);
+        REQUIRE(indexer.Next(maxSize, taken.data()) == maxSize);
+
+        // only up to the magazine capacity stays with this thread
+        indexer.Return(taken.data(), maxSize);
+
+        size_t otherThreadCount = 0;
+        thread([&indexer, &otherThreadCount]() {
+            for(auto result = indexer.Next(); !result.Empty(); result = indexer.Next()) {
+                otherThreadCount++;
+            }
+        }).join();
+        REQUIRE(otherThreadCount == maxSize - magazineCapacity);
+    }
+
+    SECTION("Threads can exit after the indexer is destroyed") {
+        using IndexerType = MagazineIndexer<ConcurrentIndexer, magazineCapacity>;
+        // the indexer is over-aligned, so it's placed in aligned stack storage rather than allocated with new
+        typename aligned_storage<sizeof(IndexerType), alignof(IndexerType)>::type indexerStorage;
+        auto* indexer = new(&indexerStorage) IndexerType(magazineCapacity);
+
+        bool taken = false;
+        bool destroyed = false;
+        mutex stateMutex;
+        condition_variable stateCondVar;
+
+        thread worker([&]() {
+            auto result = indexer->Next();
+            indexer->Return(result.Get());
+
+            unique_lock<mutex> lock(stateMutex);
+            taken = true;
+            stateCondVar.notify_all();
+            stateCondVar.wait(lock, [&destroyed] {return destroyed;});
+            // the magazine of this thread is drained here, with its indexer gone
+        });
+
+        {
+            unique_lock<mutex> lock(stateMutex);
+            stateCondVar.wait(lock, [&taken] {return taken;});
+            indexer->~IndexerType();
+            destroyed = true;
+            stateCondVar.notify_all();
+        }
+
+        worker.join();
+        REQUIRE(destroyed);
+    }
+
+    SECTION("Pool backed by a magazine indexer") {
+        constexpr const IndexSizeT poolSize = 10;
+        RuntimePool<int, MagazineIndexer<ConcurrentIndexer, magazineCapacity>> pool(poolSize);
+
+        vector<decltype(pool)::Handle> handles;
+        for(IndexSizeT i = 0 ; i < poolSize ; i++) {
+            auto handle = pool.TakeHandle();
+            REQUIRE_FALSE(handle.Empty());
+            handles.push_back(std::move(handle));
+        }
+
+        REQUIRE(pool.TakeHandle().Empty());
+        handles.clear();
+        REQUIRE(pool.TakeBatch(poolSize, handles) == poolSize);
+    }
+}
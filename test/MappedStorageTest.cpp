@@ -0,0 +1,112 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "../src/ConcurrentIndexer.h"
+#include "../src/MappedStorage.h"
+#include "../src/MemoryMapping.h"
+#include "TestTypes.h"
+
+using namespace dxpool;
+using namespace std;
+
+TEST_CASE("Memory mapping", "[storage][mapping]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+    const size_t requested = 10000;
+    const auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+    SECTION("Empty mapping") {
+        MemoryMapping mapping(0, MappingOptions{});
+        REQUIRE(mapping.Data() == nullptr);
+        REQUIRE(mapping.Size() == 0);
+    }
+
+    SECTION("Normal pages are zero initialized and page aligned") {
+        MemoryMapping mapping(requested, MappingOptions{}.Populate(true));
+        REQUIRE(mapping.Data() != nullptr);
+        REQUIRE(mapping.Size() >= requested);
+        REQUIRE(mapping.Size() % pageSize == 0);
+        REQUIRE(reinterpret_cast<uintptr_t>(mapping.Data()) % pageSize == 0); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        REQUIRE_FALSE(mapping.UsesExplicitHugePages());
+
+        auto* bytes = static_cast<unsigned char*>(mapping.Data());
+        for(size_t i = 0 ; i < mapping.Size() ; i++) {
+            REQUIRE(bytes[i] == 0); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+    }
+
+    SECTION("Transparent huge pages are aligned to the huge page size") {
+        MemoryMapping mapping(requested, MappingOptions{}.WithHugePages(HugePages::Transparent).Populate(true));
+        REQUIRE(mapping.Data() != nullptr);
+        REQUIRE(mapping.Size() % MemoryMapping::HugePageSize() == 0);
+        REQUIRE(reinterpret_cast<uintptr_t>(mapping.Data()) % MemoryMapping::HugePageSize() == 0); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+
+    SECTION("Explicit huge pages fall back when not available") {
+        // succeeds whether or not the system has huge pages reserved
+        MemoryMapping mapping(requested, MappingOptions{}.WithHugePages(HugePages::Explicit));
+        REQUIRE(mapping.Data() != nullptr);
+        REQUIRE(mapping.Size() >= requested);
+
+        static_cast<char*>(mapping.Data())[requested - 1] = 1; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    SECTION("Locking is best effort") {
+        MemoryMapping mapping(pageSize, MappingOptions{}.Lock(true));
+        REQUIRE(mapping.Data() != nullptr);
+        // may not be locked if RLIMIT_MEMLOCK is too low
+        (void)mapping.Locked();
+    }
+}
+
+TEST_CASE("Mapped storage pool", "[pool][storage][mapping]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+    constexpr const IndexSizeT poolSize = 1000;
+
+    SECTION("Items are default constructed when first acquired") {
+        MappedStorage<ResetableNoCopyMoveObject> storage(poolSize, MappingOptions{}.WithHugePages(HugePages::Transparent));
+        REQUIRE(storage.size() == poolSize);
+        REQUIRE(storage.Mapping().Size() >= poolSize * sizeof(ResetableNoCopyMoveObject));
+
+        for(IndexSizeT i = 0 ; i < poolSize ; i++) {
+            storage.Acquire(i);
+            REQUIRE(storage[i].Value() == ResetableNoCopyMoveObject::DefaultNonCopiableObjectValue);
+        }
+    }
+
+    SECTION("Items are created by an initializer") {
+        const int initialValue = 7;
+        MappedStorage<ResetableNoCopyMoveObject> storage(poolSize, MappingOptions{}, ConstructItemsWith<ResetableNoCopyMoveObject>(initialValue));
+        storage.Acquire(3);
+        REQUIRE(storage[3].Value() == initialValue);
+
+        storage[3].Reset();
+        storage.Acquire(3);
+        REQUIRE(storage[3].WasReset());
+    }
+
+    SECTION("Take and return items") {
+        MappedPool<ResetableNoCopyMoveObject, ConcurrentIndexer> pool(poolSize, MappingOptions{}.WithHugePages(HugePages::Explicit).Populate(true));
+        REQUIRE(pool.Size() == poolSize);
+
+        vector<decltype(pool)::Handle> handles;
+        REQUIRE(pool.TakeBatch(poolSize, handles) == poolSize);
+        REQUIRE(pool.TakeHandle().Empty());
+
+        set<ResetableNoCopyMoveObject*> addresses;
+        for(auto& handle: handles) {
+            REQUIRE(handle.Get()->Value() == ResetableNoCopyMoveObject::DefaultNonCopiableObjectValue);
+            addresses.insert(handle.Get());
+        }
+        REQUIRE(addresses.size() == poolSize);
+
+        pool.ReturnBatch(handles);
+        auto item = pool.Take();
+        REQUIRE(item.Get()->WasReset());
+    }
+
+    SECTION("Default options use normal pages") {
+        MappedPool<int> pool(poolSize);
+        auto item = pool.Take();
+        REQUIRE(*item.Get() == 0);
+    }
+}
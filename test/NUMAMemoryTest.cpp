@@ -0,0 +1,58 @@
+#include <catch2/catch_test_macros.hpp>
+#include <set>
+#include <vector>
+
+#include "../src/MappedStorage.h"
+#include "../src/MemoryMapping.h"
+#include "../src/NUMAMemory.h"
+#include "../src/Processor.h"
+
+using namespace dxpool;
+using namespace std;
+
+TEST_CASE("NUMA bound memory", "[storage][numa]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+    const auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    constexpr const size_t pageCount = 16;
+
+    Processor processor;
+    const auto nodes = processor.FindAvailableNumaNodes();
+    REQUIRE_FALSE(nodes.empty());
+    REQUIRE(NUMAMemory::OnlineNodes().size() >= 1);
+
+    SECTION("Pages are placed on the requested node") {
+        for(const auto& node: nodes) {
+            MemoryMapping mapping(pageCount * pageSize, MappingOptions{}.OnNUMANode(node).Populate(true));
+            REQUIRE(mapping.BoundToNUMANode() == NUMAMemory::IsNUMASystem());
+
+            for(size_t page = 0 ; page < pageCount ; page++) {
+                const int nodeID = NUMAMemory::NodeOfAddress(static_cast<char*>(mapping.Data()) + page * pageSize); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                // negative if page placement cannot be queried, e.g. move_pages is not permitted
+                if(nodeID >= 0) {
+                    REQUIRE(static_cast<unsigned int>(nodeID) == node.GetID());
+                }
+            }
+        }
+    }
+
+    SECTION("Pool items are placed on the requested node") {
+        const auto& node = *nodes.begin();
+        constexpr const IndexSizeT poolSize = 4096;
+        MappedPool<long> pool(poolSize, node); // NOLINT(google-runtime-int)
+
+        vector<decltype(pool)::Handle> handles;
+        REQUIRE(pool.TakeBatch(poolSize, handles) == poolSize);
+
+        for(const auto& handle: handles) {
+            const int nodeID = NUMAMemory::NodeOfAddress(handle.Get());
+            if(nodeID >= 0) {
+                REQUIRE(static_cast<unsigned int>(nodeID) == node.GetID());
+            }
+        }
+    }
+
+    SECTION("Without a node, memory is not bound") {
+        MemoryMapping mapping(pageSize, MappingOptions{});
+        REQUIRE_FALSE(mapping.BoundToNUMANode());
+        REQUIRE_FALSE(NUMAMemory::BindToNode(nullptr, pageSize, 0));
+    }
+}
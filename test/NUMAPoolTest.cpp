@@ -0,0 +1,136 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <list>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "../src/ConcurrentIndexer.h"
+#include "../src/NUMAMemory.h"
+#include "../src/NUMAPool.h"
+#include "../src/Processor.h"
+#include "TestTypes.h"
+
+using namespace dxpool;
+using namespace std;
+
+TEST_CASE("NUMA pool", "[numapool]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+    constexpr const IndexSizeT itemsPerNode = 8;
+
+    Processor processor;
+    const auto availableNodes = processor.FindAvailableNumaNodes();
+    REQUIRE_FALSE(availableNodes.empty());
+
+    SECTION("Invalid arguments") {
+        using PoolType = NUMAPool<int>;
+        REQUIRE_THROWS_AS(PoolType(0), InvalidNUMAPoolArgumentsError);
+        REQUIRE_THROWS_AS(PoolType(itemsPerNode, set<NUMANode>{}), InvalidNUMAPoolArgumentsError);
+    }
+
+    SECTION("One shard per available NUMA node") {
+        NUMAPool<ResetableNoCopyMoveObject> pool(itemsPerNode);
+        REQUIRE(pool.ShardCount() == availableNodes.size());
+        REQUIRE(pool.Size() == itemsPerNode * availableNodes.size());
+
+        // the first item comes from the shard of the node this thread is running on
+        const int currentNode = NUMAMemory::CurrentNode();
+        auto item = pool.Take();
+        REQUIRE_FALSE(item.Empty());
+        REQUIRE(item.Get()->Value() == ResetableNoCopyMoveObject::DefaultNonCopiableObjectValue);
+        if(currentNode >= 0) {
+            REQUIRE(pool.NodeOf(item.Get()) == static_cast<unsigned int>(currentNode));
+        }
+    }
+
+    SECTION("Falls back to other shards and returns items to their shard") {
+        // a node without cores that the calling thread can never run on
+        const auto& localNode = *availableNodes.begin();
+        const unsigned int remoteNodeID = NUMAMemory::OnlineNodes().back() + 1;
+        set<NUMANode> nodes{localNode, NUMANode(remoteNodeID, {})};
+
+        NUMAPool<ResetableNoCopyMoveObject, ConcurrentIndexer> pool(itemsPerNode, nodes);
+        REQUIRE(pool.Size() == 2 * itemsPerNode);
+
+        vector<decltype(pool)::Handle> localHandles;
+        vector<decltype(pool)::Handle> remoteHandles;
+        for(IndexSizeT i = 0 ; i < pool.Size() ; i++) {
+            auto handle = pool.TakeHandle();
+            REQUIRE_FALSE(handle.Empty());
+
+            if(pool.NodeOf(handle.Get()) == remoteNodeID) {
+                remoteHandles.push_back(std::move(handle));
+            } else {
+                // the local shard is used before any remote one
+                REQUIRE(remoteHandles.empty());
+                localHandles.push_back(std::move(handle));
+            }
+        }
+
+        REQUIRE(localHandles.size() == itemsPerNode);
+        REQUIRE(remoteHandles.size() == itemsPerNode);
+        REQUIRE(pool.TakeHandle().Empty());
+
+        // items returned from the remote shard go back to it
+        remoteHandles.clear();
+        vector<PoolItem<ResetableNoCopyMoveObject>> items;
+        for(IndexSizeT i = 0 ; i < itemsPerNode ; i++) {
+            auto item = pool.Take();
+            REQUIRE_FALSE(item.Empty());
+            REQUIRE(pool.NodeOf(item.Get()) == remoteNodeID);
+            REQUIRE(item.Get()->WasReset());
+            items.push_back(std::move(item));
+        }
+        REQUIRE(pool.Take().Empty());
+    }
+
+    SECTION("Shards are pools with their own statistics") {
+        NUMAPool<int, ConcurrentIndexer, NoReset, ShardedStats> pool(itemsPerNode);
+        {
+            auto item = pool.Take();
+            REQUIRE_FALSE(item.Empty());
+        }
+
+        uint64_t taken = 0;
+        uint64_t returned = 0;
+        for(size_t i = 0 ; i < pool.ShardCount() ; i++) {
+            REQUIRE(pool.Shard(i).Size() == itemsPerNode);
+            taken += pool.Shard(i).Stats().taken;
+            returned += pool.Shard(i).Stats().returned;
+        }
+
+        REQUIRE(taken == 1);
+        REQUIRE(returned == 1);
+    }
+
+    SECTION("Take and return from multiple threads") {
+        const int threadCount = 8;
+        const int iterations = 500;
+        NUMAPool<int, ConcurrentIndexer> pool(itemsPerNode);
+
+        atomic<bool> failed{false};
+        list<thread> threads;
+
+        for(int i = 0 ; i < threadCount ; i++) {
+            threads.emplace_back([&pool, &failed]() {
+                for(int iteration = 0 ; iteration < iterations ; iteration++) {
+                    auto handle = pool.TakeHandle();
+                    if(handle.Empty()) {
+                        continue;
+                    }
+
+                    *handle.Get() += 1;
+                    if(*handle.Get() != 1) {
+                        failed = true;
+                    }
+                    *handle.Get() -= 1;
+                }
+            });
+        }
+
+        for(auto& poolThread: threads) {
+            poolThread.join();
+        }
+
+        REQUIRE_FALSE(failed);
+    }
+}
@@ -0,0 +1,141 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "../src/ConcurrentIndexer.h"
+#include "../src/MutexIndexer.h"
+#include "../src/Occupancy.h"
+#include "../src/Pool.h"
+#include "../src/PoolStorage.h"
+#include "TestTypes.h"
+
+using namespace dxpool;
+using namespace std;
+
+template<typename ItemType, typename Indexer = MutexIndexer>
+using OccupancyPool = Pool<ItemType, vector<ItemType>, Indexer, 0, NoStats, ResetOnReturn, OccupancyBitmap>;
+
+namespace {
+
+auto SetIndices(const OccupancyBitmap& bitmap) -> vector<IndexSizeT> {
+    vector<IndexSizeT> indices;
+    bitmap.ForEachSet([&indices](IndexSizeT index) {
+        indices.push_back(index);
+    });
+
+    return indices;
+}
+
+auto ClearIndices(const OccupancyBitmap& bitmap) -> vector<IndexSizeT> {
+    vector<IndexSizeT> indices;
+    bitmap.ForEachClear([&indices](IndexSizeT index) {
+        indices.push_back(index);
+    });
+
+    return indices;
+}
+
+} // namespace
+
+TEST_CASE("Occupancy bitmap", "[occupancy]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("Bits set and cleared across words") {
+        OccupancyBitmap bitmap(130);
+        REQUIRE(SetIndices(bitmap).empty());
+        REQUIRE(ClearIndices(bitmap).size() == 130);
+
+        bitmap.Set(0);
+        bitmap.Set(63);
+        bitmap.Set(64);
+        bitmap.Set(129);
+        REQUIRE(SetIndices(bitmap) == vector<IndexSizeT>{0, 63, 64, 129});
+        REQUIRE(ClearIndices(bitmap).size() == 126);
+
+        bitmap.Clear(63);
+        REQUIRE(SetIndices(bitmap) == vector<IndexSizeT>{0, 64, 129});
+    }
+
+    SECTION("Bits past the last item are never visited") {
+        OccupancyBitmap bitmap(3);
+        bitmap.Set(1);
+
+        REQUIRE(ClearIndices(bitmap) == vector<IndexSizeT>{0, 2});
+    }
+
+    SECTION("Full words") {
+        OccupancyBitmap bitmap(128);
+        for(IndexSizeT i = 0 ; i < 128 ; i++) {
+            bitmap.Set(i);
+        }
+
+        REQUIRE(SetIndices(bitmap).size() == 128);
+        REQUIRE(ClearIndices(bitmap).empty());
+    }
+}
+
+TEST_CASE("Pool occupancy iteration", "[pool][occupancy]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("Only items in use are visited") {
+        OccupancyPool<int> pool(200);
+        vector<OccupancyPool<int>::Handle> handles;
+        REQUIRE(pool.TakeBatch(3, handles) == 3);
+
+        vector<int*> visited;
+        pool.ForEachInUse([&visited](IndexSizeT /* index */, int* item) {
+            visited.push_back(item);
+        });
+
+        REQUIRE(visited.size() == 3);
+        for(auto& handle: handles) {
+            REQUIRE(find(visited.begin(), visited.end(), handle.Get()) != visited.end());
+        }
+
+        IndexSizeT freeCount = 0;
+        pool.ForEachFree([&freeCount](IndexSizeT /* index */) {
+            freeCount++;
+        });
+        REQUIRE(freeCount == 197);
+
+        pool.ReturnBatch(handles);
+        visited.clear();
+        pool.ForEachInUse([&visited](IndexSizeT /* index */, int* item) {
+            visited.push_back(item);
+        });
+        REQUIRE(visited.empty());
+    }
+
+    SECTION("Items taken with every take operation are tracked") {
+        OccupancyPool<ResetableCopyMoveObject<>, ConcurrentIndexer> pool(4);
+        auto item = pool.Take();
+        auto handle = pool.TakeHandle();
+        auto shared = pool.TakeShared();
+
+        vector<IndexSizeT> inUse;
+        pool.ForEachInUse([&inUse](IndexSizeT index, ResetableCopyMoveObject<>* /* item */) {
+            inUse.push_back(index);
+        });
+
+        REQUIRE(inUse.size() == 3);
+        REQUIRE(find(inUse.begin(), inUse.end(), item.PoolIndex()) != inUse.end());
+        REQUIRE(find(inUse.begin(), inUse.end(), handle.PoolIndex()) != inUse.end());
+        REQUIRE(find(inUse.begin(), inUse.end(), shared.PoolIndex()) != inUse.end());
+    }
+
+    SECTION("Returned items are no longer in use") {
+        Pool<int, array<int, 2>, MutexIndexer, 2, NoStats, ResetOnReturn, OccupancyBitmap> pool;
+        IndexSizeT index = 0;
+        {
+            auto item = pool.Take();
+            index = item.PoolIndex();
+        }
+
+        vector<IndexSizeT> freeIndices;
+        pool.ForEachFree([&freeIndices](IndexSizeT freeIndex) {
+            freeIndices.push_back(freeIndex);
+        });
+
+        REQUIRE(freeIndices.size() == 2);
+        REQUIRE(find(freeIndices.begin(), freeIndices.end(), index) != freeIndices.end());
+    }
+}
@@ -0,0 +1,74 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "../src/CacheLine.h"
+#include "../src/ConcurrentIndexer.h"
+#include "../src/PaddedStorage.h"
+#include "TestTypes.h"
+
+using namespace dxpool;
+using namespace std;
+
+TEST_CASE("Padded storage", "[pool][storage][padded]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+    constexpr const IndexSizeT poolSize = 64;
+    const size_t lineSize = CacheLineSize();
+
+    SECTION("Cache line size is a power of two") {
+        REQUIRE(lineSize > 0);
+        REQUIRE((lineSize & (lineSize - 1)) == 0);
+    }
+
+    SECTION("Every item starts on its own cache line") {
+        PaddedStorage<int> storage(poolSize);
+        REQUIRE(storage.size() == poolSize);
+        REQUIRE(storage.Stride() == lineSize);
+
+        set<uintptr_t> lines;
+        for(IndexSizeT i = 0 ; i < poolSize ; i++) {
+            const auto address = reinterpret_cast<uintptr_t>(&storage[i]); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            REQUIRE(address % lineSize == 0);
+            REQUIRE(storage[i] == 0);
+            lines.insert(address / lineSize);
+        }
+        REQUIRE(lines.size() == poolSize);
+    }
+
+    SECTION("Items larger than a cache line take whole lines") {
+        struct LargeItem {
+            char data[100]{}; // NOLINT(cppcoreguidelines-avoid-c-arrays, hicpp-avoid-c-arrays, modernize-avoid-c-arrays)
+        };
+
+        PaddedStorage<LargeItem> storage(poolSize);
+        REQUIRE(storage.Stride() % lineSize == 0);
+        REQUIRE(storage.Stride() >= sizeof(LargeItem));
+    }
+
+    SECTION("Custom stride") {
+        PaddedStorage<int> twoLines(poolSize, ItemStride(2 * lineSize));
+        REQUIRE(twoLines.Stride() == 2 * lineSize);
+        REQUIRE(reinterpret_cast<uintptr_t>(&twoLines[1]) - reinterpret_cast<uintptr_t>(&twoLines[0]) == 2 * lineSize); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+        // a stride is never smaller than the item or misaligned
+        PaddedStorage<uint64_t> small(poolSize, ItemStride(3));
+        REQUIRE(small.Stride() == sizeof(uint64_t));
+        PaddedStorage<uint64_t> misaligned(poolSize, ItemStride(sizeof(uint64_t) + 1));
+        REQUIRE(misaligned.Stride() == 2 * sizeof(uint64_t));
+    }
+
+    SECTION("Take and return items") {
+        PaddedPool<ResetableNoCopyMoveObject, ConcurrentIndexer> pool(poolSize);
+        REQUIRE(pool.Size() == poolSize);
+
+        vector<decltype(pool)::Handle> handles;
+        REQUIRE(pool.TakeBatch(poolSize, handles) == poolSize);
+        for(const auto& handle: handles) {
+            REQUIRE(handle.Get()->Value() == ResetableNoCopyMoveObject::DefaultNonCopiableObjectValue);
+            REQUIRE(reinterpret_cast<uintptr_t>(handle.Get()) % lineSize == 0); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        }
+
+        pool.ReturnBatch(handles);
+        REQUIRE(pool.Take().Get()->WasReset());
+    }
+}
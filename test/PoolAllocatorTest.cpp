@@ -0,0 +1,202 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <new>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../src/ConcurrentIndexer.h"
+#include "../src/MutexIndexer.h"
+#include "../src/PoolAllocator.h"
+
+using namespace dxpool;
+using namespace std;
+
+TEST_CASE("Block pool", "[allocator]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("Blocks are aligned and rounded up to the alignment") {
+        BlockPool<> blocks(4, 20, 16);
+        REQUIRE(blocks.BlockSize() == 32);
+        REQUIRE(blocks.Size() == 4);
+
+        vector<void*> taken;
+        for(int i = 0 ; i < 4 ; i++) {
+            void* block = blocks.TakeBlock();
+            REQUIRE(block != nullptr);
+            REQUIRE(reinterpret_cast<std::uintptr_t>(block) % 16 == 0); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            REQUIRE(blocks.Owns(block));
+            taken.push_back(block);
+        }
+
+        REQUIRE(blocks.TakeBlock() == nullptr);
+
+        blocks.ReturnBlock(taken[2]);
+        REQUIRE(blocks.TakeBlock() == taken[2]);
+    }
+
+    SECTION("Requests that fit a block") {
+        BlockPool<ConcurrentIndexer> blocks(1, 64, 8);
+        REQUIRE(blocks.Fits(64, 8));
+        REQUIRE(blocks.Fits(1, 1));
+        REQUIRE_FALSE(blocks.Fits(65, 8));
+        REQUIRE_FALSE(blocks.Fits(8, 16));
+
+        int onStack = 0;
+        REQUIRE_FALSE(blocks.Owns(&onStack));
+    }
+
+    SECTION("Invalid arguments") {
+        REQUIRE_THROWS_AS(BlockPool<>(1, 0), InvalidBlockPoolArgumentsError);
+        REQUIRE_THROWS_AS(BlockPool<>(1, 8, 3), InvalidBlockPoolArgumentsError);
+    }
+}
+
+TEST_CASE("Pool allocator", "[allocator]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("List nodes are taken from the block pool") {
+        BlockPool<> blocks(16, 64);
+        list<int, PoolAllocator<int>> values{PoolAllocator<int>(blocks)};
+
+        for(int i = 0 ; i < 16 ; i++) {
+            values.push_back(i);
+        }
+
+        for(auto& value: values) {
+            REQUIRE(blocks.Owns(&value));
+        }
+
+        REQUIRE_THROWS_AS(values.push_back(16), std::bad_alloc);
+
+        values.pop_front();
+        values.push_back(16);
+        REQUIRE(values.size() == 16);
+        REQUIRE(values.back() == 16);
+    }
+
+    SECTION("Map nodes") {
+        using MapAllocator = PoolAllocator<pair<const int, string>, ConcurrentIndexer>;
+        BlockPool<ConcurrentIndexer> blocks(8, 128);
+        map<int, string, less<int>, MapAllocator> values{MapAllocator(blocks)};
+
+        for(int i = 0 ; i < 8 ; i++) {
+            values.emplace(i, to_string(i));
+        }
+
+        REQUIRE(values.size() == 8);
+        REQUIRE(values.at(5) == "5");
+
+        values.clear();
+        for(int i = 0 ; i < 8 ; i++) {
+            values.emplace(i, to_string(i * 2));
+        }
+
+        REQUIRE(values.at(5) == "10");
+    }
+
+    SECTION("Unordered map buckets don't fit a block and use the default allocator") {
+        using MapAllocator = PoolAllocator<pair<const int, int>>;
+        BlockPool<> blocks(64, 32);
+        unordered_map<int, int, hash<int>, equal_to<int>, MapAllocator> values(16, hash<int>(), equal_to<int>(), MapAllocator(blocks));
+
+        for(int i = 0 ; i < 64 ; i++) {
+            values[i] = i;
+        }
+
+        REQUIRE(values.size() == 64);
+        REQUIRE(values[63] == 63);
+    }
+
+    SECTION("Rebound allocators share the block pool and compare equal") {
+        BlockPool<> blocks(1, 64);
+        PoolAllocator<int> intAllocator(blocks);
+        PoolAllocator<double> doubleAllocator(intAllocator);
+        BlockPool<> otherBlocks(1, 64);
+
+        REQUIRE(intAllocator == doubleAllocator);
+        REQUIRE(intAllocator != PoolAllocator<int>(otherBlocks));
+        REQUIRE(&doubleAllocator.Blocks() == &blocks);
+
+        double* value = doubleAllocator.allocate(1);
+        REQUIRE(blocks.Owns(value));
+        doubleAllocator.deallocate(value, 1);
+
+        int* values = intAllocator.allocate(4);
+        REQUIRE_FALSE(blocks.Owns(values));
+        intAllocator.deallocate(values, 4);
+    }
+
+    SECTION("Allocating from many threads") {
+        constexpr const size_t threadCount = 8;
+        constexpr const int iterations = 200;
+        BlockPool<ConcurrentIndexer> blocks(threadCount * 4, 64);
+
+        vector<thread> threads;
+        for(size_t t = 0 ; t < threadCount ; t++) {
+            threads.emplace_back([&blocks]() {
+                for(int n = 0 ; n < iterations ; n++) {
+                    list<int, PoolAllocator<int, ConcurrentIndexer>> values{PoolAllocator<int, ConcurrentIndexer>(blocks)};
+                    values.push_back(n);
+                    values.push_back(n + 1);
+                }
+            });
+        }
+
+        for(auto& thread: threads) {
+            thread.join();
+        }
+
+        vector<void*> taken;
+        for(size_t i = 0 ; i < blocks.Size() ; i++) {
+            taken.push_back(blocks.TakeBlock());
+            REQUIRE(taken.back() != nullptr);
+        }
+    }
+}
+
+#ifdef DXPOOL_HAS_MEMORY_RESOURCE
+
+TEST_CASE("Pool memory resource", "[allocator][pmr]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("Nodes of pmr containers are taken from the blocks") {
+        PoolMemoryResource<> resource(32, 64);
+        std::pmr::list<int> values(&resource);
+
+        for(int i = 0 ; i < 32 ; i++) {
+            values.push_back(i);
+        }
+
+        for(auto& value: values) {
+            REQUIRE(resource.Blocks().Owns(&value));
+        }
+
+        REQUIRE_THROWS_AS(values.push_back(32), std::bad_alloc);
+    }
+
+    SECTION("Large allocations go upstream") {
+        PoolMemoryResource<ConcurrentIndexer> resource(80, 48);
+        std::pmr::unordered_map<int, int> values(&resource);
+
+        for(int i = 0 ; i < 64 ; i++) {
+            values[i] = i;
+        }
+
+        REQUIRE(values.size() == 64);
+
+        void* large = resource.allocate(1024);
+        REQUIRE_FALSE(resource.Blocks().Owns(large));
+        resource.deallocate(large, 1024);
+    }
+
+    SECTION("Resources are only equal to themselves") {
+        PoolMemoryResource<> resource(1, 64);
+        PoolMemoryResource<> other(1, 64);
+
+        REQUIRE(resource.is_equal(resource));
+        REQUIRE_FALSE(resource.is_equal(other));
+    }
+}
+
+#endif // DXPOOL_HAS_MEMORY_RESOURCE
@@ -0,0 +1,107 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "../src/PoolHandle.h"
+#include "../src/MutexIndexer.h"
+#include "../src/ConcurrentIndexer.h"
+#include "../src/Pool.h"
+#include "TestTypes.h"
+
+using namespace dxpool;
+using namespace std;
+
+template<typename PoolType>
+auto verifyHandleTakeAll(PoolType& pool) -> void {
+    vector<typename PoolType::Handle> handles;
+
+    for(size_t i = 0 ; i < pool.Size() ; i++) {
+        auto handle = pool.TakeHandle();
+        REQUIRE_FALSE(handle.Empty());
+        REQUIRE(handle.Get()->Value() == ResetableCopyMoveObject<>::DefaultNonCopiableObjectValue);
+        handles.push_back(std::move(handle));
+    }
+
+    REQUIRE(pool.TakeHandle().Empty());
+
+    // releasing the handles returns all items to the pool
+    handles.clear();
+
+    for(size_t i = 0 ; i < pool.Size() ; i++) {
+        auto handle = pool.TakeHandle();
+        REQUIRE_FALSE(handle.Empty());
+        handles.push_back(std::move(handle));
+    }
+}
+
+TEST_CASE("Pool handle", "[poolhandle]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("Empty handle by default") {
+        PoolHandle<StaticPool<int, 1>> handle;
+        REQUIRE(handle.Empty());
+    }
+
+    SECTION("Take all items from a static pool") {
+        constexpr const IndexSizeT poolSize = 7;
+        StaticPool<ResetableNoCopyMoveObject, poolSize, ConcurrentIndexer> pool;
+        verifyHandleTakeAll(pool);
+    }
+
+    SECTION("Take all items from a runtime pool") {
+        constexpr const IndexSizeT poolSize = 9;
+        RuntimePool<ResetableCopyMoveObject<>, MutexIndexer> pool(poolSize);
+        verifyHandleTakeAll(pool);
+    }
+
+    SECTION("Reset on destruction") {
+        StaticPool<ResetableNoCopyMoveObject, 1> pool;
+        ResetableNoCopyMoveObject* obj = nullptr;
+        {
+            auto handle = pool.TakeHandle();
+            REQUIRE_FALSE(handle.Empty());
+            REQUIRE(handle.PoolIndex() == 0);
+            obj = handle.Get();
+            REQUIRE(pool.TakeHandle().Empty());
+        }
+
+        REQUIRE(obj->WasReset());
+        REQUIRE(obj->Value() == 0);
+        REQUIRE_FALSE(pool.TakeHandle().Empty());
+    }
+
+    SECTION("Invoke custom reseter") {
+        const int resetValue = 31;
+        RuntimePool<int> pool(1, [](int* item) {
+            *item = resetValue;
+        });
+
+        int* value = nullptr;
+        {
+            auto handle = pool.TakeHandle();
+            value = handle.Get();
+            *value = resetValue + 1;
+        }
+
+        REQUIRE(*value == resetValue);
+    }
+
+    SECTION("Move constructor") {
+        StaticPool<ResetableNoCopyMoveObject, 1> pool;
+        {
+            auto original = pool.TakeHandle();
+            const auto* item = original.Get();
+            auto moved(std::move(original));
+
+            REQUIRE(original.Empty()); // NOLINT(bugprone-use-after-move,clang-analyzer-cplusplus.Move)
+            REQUIRE_FALSE(moved.Empty());
+            REQUIRE(moved.Get() == item);
+            REQUIRE(pool.TakeHandle().Empty());
+        }
+
+        // only the moved handle returns the item
+        auto first = pool.TakeHandle();
+        REQUIRE_FALSE(first.Empty());
+        REQUIRE(pool.TakeHandle().Empty());
+    }
+}
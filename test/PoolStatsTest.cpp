@@ -0,0 +1,167 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+#include <thread>
+#include <vector>
+
+#include "../src/ConcurrentIndexer.h"
+#include "../src/MutexIndexer.h"
+#include "../src/Pool.h"
+#include "../src/PoolStats.h"
+
+using namespace dxpool;
+using namespace std;
+
+template<typename Indexer>
+using StatsPool = Pool<int, vector<int>, Indexer, 0, ShardedStats>;
+
+TEST_CASE("Sharded statistics", "[stats]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("Counters start at zero") {
+        const ShardedStats stats;
+        const auto snapshot = stats.Snapshot();
+        REQUIRE(snapshot.taken == 0);
+        REQUIRE(snapshot.inUse == 0);
+        REQUIRE(snapshot.highWatermark == 0);
+        REQUIRE(snapshot.lockWaitNanos == 0);
+    }
+
+    SECTION("Counters from all threads are added up") {
+        constexpr const size_t threadCount = ShardedStats::ShardCount + 3;
+        constexpr const uint64_t increments = 1000;
+        ShardedStats stats;
+
+        vector<thread> threads;
+        for(size_t i = 0 ; i < threadCount ; i++) {
+            threads.emplace_back([&stats]() {
+                for(uint64_t n = 0 ; n < increments ; n++) {
+                    stats.Add(PoolStat::Taken, 2);
+                    stats.Add(PoolStat::Returned, 1);
+                    stats.Add(PoolStat::CASRetries, 1);
+                }
+            });
+        }
+
+        for(auto& thread: threads) {
+            thread.join();
+        }
+
+        const auto snapshot = stats.Snapshot();
+        REQUIRE(snapshot.taken == 2 * increments * threadCount);
+        REQUIRE(snapshot.returned == increments * threadCount);
+        REQUIRE(snapshot.inUse == increments * threadCount);
+        REQUIRE(snapshot.casRetries == increments * threadCount);
+    }
+
+    SECTION("High watermark keeps the maximum observed") {
+        ShardedStats stats;
+        stats.ObserveInUse(3);
+        stats.ObserveInUse(7);
+        stats.ObserveInUse(5);
+        REQUIRE(stats.Snapshot().highWatermark == 7);
+    }
+
+    SECTION("No statistics") {
+        NoStats stats;
+        stats.Add(PoolStat::Taken, 1);
+        stats.ObserveInUse(1);
+        REQUIRE(stats.Snapshot().taken == 0);
+        REQUIRE(stats.Snapshot().highWatermark == 0);
+    }
+}
+
+TEMPLATE_TEST_CASE("Pool statistics", "[stats]", BasicMutexIndexer<ShardedStats>, BasicConcurrentIndexer<ShardedStats>) { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+    constexpr const IndexSizeT poolSize = 5;
+
+    SECTION("Take, return and failures") {
+        StatsPool<TestType> pool(poolSize);
+        {
+            auto first = pool.Take();
+            auto second = pool.TakeHandle();
+            auto third = pool.TakeShared();
+
+            const auto snapshot = pool.Stats();
+            REQUIRE(snapshot.taken == 3);
+            REQUIRE(snapshot.inUse == 3);
+            REQUIRE(snapshot.highWatermark == 3);
+        }
+
+        vector<typename StatsPool<TestType>::Handle> handles;
+        REQUIRE(pool.TakeBatch(poolSize + 1, handles) == poolSize);
+        REQUIRE(pool.Take().Empty());
+
+        auto snapshot = pool.Stats();
+        REQUIRE(snapshot.taken == 3 + poolSize);
+        REQUIRE(snapshot.returned == 3);
+        REQUIRE(snapshot.inUse == poolSize);
+        REQUIRE(snapshot.highWatermark == poolSize);
+        REQUIRE(snapshot.takeFailures == 2);
+
+        pool.ReturnBatch(handles);
+        snapshot = pool.Stats();
+        REQUIRE(snapshot.inUse == 0);
+        REQUIRE(snapshot.returned == 3 + poolSize);
+        REQUIRE(snapshot.highWatermark == poolSize);
+    }
+
+    SECTION("Concurrent use") {
+        StatsPool<TestType> pool(poolSize);
+        constexpr const size_t threadCount = 8;
+        constexpr const int iterations = 2000;
+        vector<thread> threads;
+
+        for(size_t i = 0 ; i < threadCount ; i++) {
+            threads.emplace_back([&pool]() {
+                for(int n = 0 ; n < iterations ; n++) {
+                    auto item = pool.TakeHandle();
+                }
+            });
+        }
+
+        for(auto& thread: threads) {
+            thread.join();
+        }
+
+        const auto snapshot = pool.Stats();
+        REQUIRE(snapshot.taken + snapshot.takeFailures == threadCount * iterations);
+        REQUIRE(snapshot.returned == snapshot.taken);
+        REQUIRE(snapshot.inUse == 0);
+        REQUIRE(snapshot.highWatermark >= 1);
+        REQUIRE(snapshot.highWatermark <= poolSize);
+    }
+}
+
+TEST_CASE("Mutex indexer lock contention", "[stats]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    constexpr const size_t threadCount = 8;
+    constexpr const int iterations = 5000;
+    BasicMutexIndexer<ShardedStats> indexer(threadCount);
+    vector<thread> threads;
+
+    for(size_t i = 0 ; i < threadCount ; i++) {
+        threads.emplace_back([&indexer]() {
+            for(int n = 0 ; n < iterations ; n++) {
+                indexer.Return(indexer.Next().Get());
+            }
+        });
+    }
+
+    for(auto& thread: threads) {
+        thread.join();
+    }
+
+    const auto snapshot = indexer.Stats();
+    REQUIRE(snapshot.taken == threadCount * iterations);
+    REQUIRE(snapshot.returned == threadCount * iterations);
+    REQUIRE(snapshot.takeFailures == 0);
+    // contention depends on scheduling, but time is only accounted when there was contention
+    REQUIRE((snapshot.lockContentions > 0 || snapshot.lockWaitNanos == 0));
+}
+
+TEST_CASE("Pool without statistics", "[stats]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    RuntimePool<int> pool(1);
+    auto item = pool.Take();
+    REQUIRE(pool.Take().Empty());
+
+    const auto snapshot = pool.Stats();
+    REQUIRE(snapshot.taken == 0);
+    REQUIRE(snapshot.takeFailures == 0);
+}
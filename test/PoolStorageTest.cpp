@@ -0,0 +1,172 @@
+#include <catch2/catch_test_macros.hpp>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include "../src/ConcurrentIndexer.h"
+#include "../src/MutexIndexer.h"
+#include "../src/Pool.h"
+#include "../src/PoolStorage.h"
+#include "TestTypes.h"
+
+using namespace dxpool;
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Counts constructions and destructions, and has no default constructor
+ *
+ */
+class CountedObject {
+  private:
+    IndexSizeT id;
+    int value;
+
+  public:
+    static int Constructed; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    static int Destroyed; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+    CountedObject(IndexSizeT objectID, int objectValue): id(objectID), value(objectValue) {
+        Constructed++;
+    }
+
+    auto ID() const -> IndexSizeT {
+        return this->id;
+    }
+
+    auto Value() const -> int {
+        return this->value;
+    }
+
+    auto Reset() -> void {
+        this->value = 0;
+    }
+
+    FORBID_COPY_MOVE_ASSIGN(CountedObject);
+
+    ~CountedObject() {
+        Destroyed++;
+    }
+};
+
+int CountedObject::Constructed = 0; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+int CountedObject::Destroyed = 0; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+} // namespace
+
+TEST_CASE("Lazy storage", "[pool][storage]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+    constexpr const IndexSizeT poolSize = 16;
+    const int initialValue = 7;
+
+    SECTION("Items are constructed the first time they are taken") {
+        CountedObject::Constructed = 0;
+        CountedObject::Destroyed = 0;
+
+        {
+            LazyPool<CountedObject> pool(poolSize, ConstructItemsWith<CountedObject>(IndexSizeT{0}, initialValue));
+            REQUIRE(pool.Size() == poolSize);
+            REQUIRE(CountedObject::Constructed == 0);
+
+            {
+                auto item = pool.Take();
+                REQUIRE_FALSE(item.Empty());
+                REQUIRE(item.Get()->Value() == initialValue);
+                REQUIRE(CountedObject::Constructed == 1);
+            }
+
+            // a returned item is reset, not constructed again
+            auto item = pool.Take();
+            REQUIRE(item.Get()->Value() == 0);
+            REQUIRE(CountedObject::Constructed == 1);
+
+            auto handle = pool.TakeHandle();
+            REQUIRE(handle.Get()->Value() == initialValue);
+            REQUIRE(CountedObject::Constructed == 2);
+        }
+
+        // only items that were constructed are destroyed
+        REQUIRE(CountedObject::Destroyed == 2);
+    }
+
+    SECTION("Items are created by an initializer receiving their index") {
+        CountedObject::Constructed = 0;
+
+        ItemInitializer<CountedObject> initializer([](void* memory, IndexSizeT index) {
+            new (memory) CountedObject(index, static_cast<int>(index) * 2);
+        });
+
+        LazyPool<CountedObject, ConcurrentIndexer> pool(poolSize, initializer);
+
+        vector<decltype(pool)::Handle> handles;
+        REQUIRE(pool.TakeBatch(poolSize, handles) == poolSize);
+        REQUIRE(CountedObject::Constructed == static_cast<int>(poolSize));
+
+        for(const auto& handle: handles) {
+            REQUIRE(handle.Get()->ID() == handle.PoolIndex());
+            REQUIRE(handle.Get()->Value() == static_cast<int>(handle.PoolIndex()) * 2);
+        }
+    }
+
+    SECTION("Movable types can be created from a factory") {
+        LazyPool<ResetableCopyMoveObject<>> pool(poolSize, ConstructItemsWithFactory<ResetableCopyMoveObject<>>([](IndexSizeT index) {
+            return ResetableCopyMoveObject<>(static_cast<int>(index) + 1);
+        }));
+
+        set<int> values;
+        vector<decltype(pool)::Handle> handles;
+        for(IndexSizeT i = 0 ; i < poolSize ; i++) {
+            auto handle = pool.TakeHandle();
+            REQUIRE(handle.Get()->Value() == static_cast<int>(handle.PoolIndex()) + 1);
+            values.insert(handle.Get()->Value());
+            handles.push_back(std::move(handle));
+        }
+
+        REQUIRE(values.size() == poolSize);
+        REQUIRE(pool.TakeHandle().Empty());
+    }
+
+    SECTION("Default constructible types need no initializer") {
+        LazyPool<ResetableNoCopyMoveObject> pool(poolSize);
+        auto item = pool.Take();
+        REQUIRE(item.Get()->Value() == ResetableNoCopyMoveObject::DefaultNonCopiableObjectValue);
+    }
+
+    SECTION("An item whose constructor throws goes back to the pool") {
+        int attempts = 0;
+        LazyPool<int> pool(1, ItemInitializer<int>([&attempts](void* memory, IndexSizeT _index) {
+            (void)_index;
+            if(attempts++ < 2) {
+                throw std::runtime_error("the first two constructions fail");
+            }
+
+            new (memory) int(initialValue);
+        }));
+
+        REQUIRE_THROWS_AS(pool.Take(), std::runtime_error);
+        vector<LazyPool<int>::Handle> handles;
+        REQUIRE_THROWS_AS(pool.TakeBatch(1, handles), std::runtime_error);
+        REQUIRE(handles.empty());
+
+        auto item = pool.Take();
+        REQUIRE(*item.Get() == initialValue);
+        REQUIRE(attempts == 3);
+    }
+
+    SECTION("Invoke custom reseter") {
+        const int resetValue = 64;
+        LazyPool<int> pool(1, ConstructItemsWith<int>(initialValue), [](int* item) {
+            *item = resetValue;
+        });
+
+        int* value = nullptr;
+        {
+            auto item = pool.Take();
+            REQUIRE(*item.Get() == initialValue);
+            value = item.Get();
+        }
+
+        REQUIRE(*value == resetValue);
+        REQUIRE(*pool.Take().Get() == resetValue);
+    }
+}
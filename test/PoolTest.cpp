@@ -6,6 +6,7 @@
 
 #include "../src/PoolItem.h"
 #include "../src/MutexIndexer.h"
+#include "../src/ConcurrentIndexer.h"
 #include "../src/Pool.h"
 #include "TestTypes.h"
 
@@ -150,4 +151,57 @@ TEST_CASE("Runtime pool tests") { // NOLINT(cppcoreguidelines-avoid-non-const-gl
         RuntimePool<ResetableCopyMoveObject<>, MutexIndexer> pool(poolSize);
         verifyReturnAfterItemOutOfScope<decltype(pool), ResetableCopyMoveObject<>>(pool);
     }
-}
\ No newline at end of file
+}
+
+template<typename PoolType>
+auto verifyTakeReturnBatch(PoolType& pool) -> void {
+    std::vector<typename PoolType::Handle> handles;
+    const IndexSizeT firstBatch = pool.Size() / 2;
+
+    REQUIRE(pool.TakeBatch(firstBatch, handles) == firstBatch);
+    REQUIRE(handles.size() == firstBatch);
+
+    // asking for more than available returns only what's left in the pool
+    REQUIRE(pool.TakeBatch(pool.Size(), handles) == pool.Size() - firstBatch);
+    REQUIRE(handles.size() == pool.Size());
+    REQUIRE(pool.TakeHandle().Empty());
+
+    for(auto& handle: handles) {
+        REQUIRE(handle.Get()->Value() == ResetableCopyMoveObject<>::DefaultNonCopiableObjectValue);
+    }
+
+    pool.ReturnBatch(handles);
+    REQUIRE(handles.empty());
+
+    REQUIRE(pool.TakeBatch(pool.Size(), handles) == pool.Size());
+    for(auto& handle: handles) {
+        REQUIRE(handle.Get()->WasReset());
+    }
+}
+
+TEST_CASE("Pool batch operations") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+    SECTION("Take and return batch, static pool") {
+        constexpr const IndexSizeT poolSize = 600;
+        StaticPool<ResetableNoCopyMoveObject, poolSize, ConcurrentIndexer> pool;
+        verifyTakeReturnBatch(pool);
+    }
+
+    SECTION("Take and return batch, runtime pool") {
+        constexpr const IndexSizeT poolSize = 13;
+        RuntimePool<ResetableCopyMoveObject<>, MutexIndexer> pool(poolSize);
+        verifyTakeReturnBatch(pool);
+    }
+
+    SECTION("Items returned when handles are destroyed") {
+        constexpr const IndexSizeT poolSize = 4;
+        RuntimePool<ResetableCopyMoveObject<>, ConcurrentIndexer> pool(poolSize);
+        {
+            std::vector<decltype(pool)::Handle> handles;
+            REQUIRE(pool.TakeBatch(poolSize, handles) == poolSize);
+        }
+
+        std::vector<decltype(pool)::Handle> handles;
+        REQUIRE(pool.TakeBatch(poolSize, handles) == poolSize);
+    }
+}
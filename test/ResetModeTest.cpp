@@ -0,0 +1,196 @@
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../src/ConcurrentIndexer.h"
+#include "../src/MutexIndexer.h"
+#include "../src/Pool.h"
+#include "../src/ResetModes.h"
+#include "../src/WorkerPool.h"
+#include "TestTypes.h"
+
+using namespace dxpool;
+using namespace std;
+
+template<IndexSizeT Size, typename ResetMode, typename Indexer = MutexIndexer>
+using ResetModePool = Pool<ResetableNoCopyMoveObject, array<ResetableNoCopyMoveObject, Size>, Indexer, Size, NoStats, ResetMode>;
+
+template<typename ResetMode, typename Indexer = ConcurrentIndexer>
+using RuntimeResetModePool = Pool<int, vector<int>, Indexer, 0, NoStats, ResetMode>;
+
+TEST_CASE("Reset on take", "[pool][reset]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("Items are reset when taken, not when returned") {
+        ResetModePool<1, ResetOnTake> pool;
+        ResetableNoCopyMoveObject* obj = nullptr;
+        {
+            auto item = pool.TakeHandle();
+            obj = item.Get();
+            REQUIRE(obj->WasReset());
+        }
+
+        REQUIRE(obj->Value() == 0);
+
+        {
+            auto item = pool.Take();
+            REQUIRE(item.Get() == obj);
+            REQUIRE(obj->WasReset());
+        }
+    }
+
+    SECTION("Custom reset callback on take") {
+        const int resetValue = 3;
+        RuntimeResetModePool<ResetOnTake, MutexIndexer> pool(1, [](int* item) {
+            *item = resetValue;
+        });
+
+        int* value = nullptr;
+        {
+            auto item = pool.TakeHandle();
+            value = item.Get();
+            REQUIRE(*value == resetValue);
+            *value = resetValue + 1;
+        }
+
+        // returned as is
+        REQUIRE(*value == resetValue + 1);
+        auto item = pool.TakeShared();
+        REQUIRE(*item.Get() == resetValue);
+    }
+
+    SECTION("Batches are returned without resetting") {
+        const int resetValue = 5;
+        RuntimeResetModePool<ResetOnTake, MutexIndexer> pool(4, [](int* item) {
+            *item = resetValue;
+        });
+
+        vector<RuntimeResetModePool<ResetOnTake, MutexIndexer>::Handle> handles;
+        REQUIRE(pool.TakeBatch(4, handles) == 4);
+        for(auto& handle: handles) {
+            REQUIRE(*handle.Get() == resetValue);
+            *handle.Get() = 0;
+        }
+
+        pool.ReturnBatch(handles);
+        REQUIRE(pool.TakeBatch(4, handles) == 4);
+        for(auto& handle: handles) {
+            REQUIRE(*handle.Get() == resetValue);
+        }
+    }
+}
+
+TEST_CASE("Background reset", "[pool][reset]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("Items are reset by the background worker") {
+        ResetModePool<2, BackgroundReset> pool;
+        ResetableNoCopyMoveObject* obj = nullptr;
+        {
+            auto item = pool.TakeHandle();
+            obj = item.Get();
+            REQUIRE_FALSE(obj->WasReset());
+        }
+
+        pool.FlushResets();
+        REQUIRE(obj->WasReset());
+
+        auto first = pool.Take();
+        auto second = pool.Take();
+        REQUIRE_FALSE(first.Empty());
+        REQUIRE_FALSE(second.Empty());
+    }
+
+    SECTION("Returned batches are reset") {
+        const int resetValue = 9;
+        constexpr const IndexSizeT poolSize = 300;
+        RuntimeResetModePool<BackgroundReset> pool(poolSize, [](int* item) {
+            *item = resetValue;
+        });
+
+        vector<RuntimeResetModePool<BackgroundReset>::Handle> handles;
+        REQUIRE(pool.TakeBatch(poolSize, handles) == poolSize);
+        for(auto& handle: handles) {
+            *handle.Get() = 0;
+        }
+
+        pool.ReturnBatch(handles);
+        pool.FlushResets();
+
+        REQUIRE(pool.TakeBatch(poolSize, handles) == poolSize);
+        for(auto& handle: handles) {
+            REQUIRE(*handle.Get() == resetValue);
+        }
+    }
+
+    SECTION("Items returned by many threads are all reset") {
+        constexpr const IndexSizeT poolSize = 16;
+        constexpr const size_t threadCount = 8;
+        constexpr const int iterations = 2000;
+        RuntimeResetModePool<BackgroundReset> pool(poolSize, [](int* item) {
+            *item = 0;
+        });
+
+        atomic<int> dirtyTakes{0};
+        vector<thread> threads;
+        for(size_t i = 0 ; i < threadCount ; i++) {
+            threads.emplace_back([&pool, &dirtyTakes]() {
+                for(int n = 0 ; n < iterations ; n++) {
+                    auto item = pool.TakeHandle();
+                    if(!item.Empty()) {
+                        if(*item.Get() != 0) {
+                            dirtyTakes++;
+                        }
+                        *item.Get() = n + 1;
+                    }
+                }
+            });
+        }
+
+        for(auto& thread: threads) {
+            thread.join();
+        }
+
+        pool.FlushResets();
+        REQUIRE(dirtyTakes.load() == 0);
+
+        vector<RuntimeResetModePool<BackgroundReset>::Handle> handles;
+        REQUIRE(pool.TakeBatch(poolSize, handles) == poolSize);
+        for(auto& handle: handles) {
+            REQUIRE(*handle.Get() == 0);
+        }
+    }
+
+    SECTION("Reset with a worker pool") {
+        const int resetValue = 7;
+        WorkerPoolBuilder builder;
+        auto workers = builder.WithThreadsPerCore(1).OnCores({Core{0}}).Build();
+
+        RuntimeResetModePool<BackgroundReset> pool(2, [](int* item) {
+            *item = resetValue;
+        }, *workers);
+
+        int* value = nullptr;
+        {
+            auto item = pool.Take();
+            value = item.Get();
+            *value = 0;
+        }
+
+        pool.FlushResets();
+        REQUIRE(*value == resetValue);
+    }
+
+    SECTION("Pending resets complete when the pool is destroyed") {
+        atomic<int> resets{0};
+        {
+            RuntimeResetModePool<BackgroundReset> pool(1, [&resets](int* /* item */) {
+                resets++;
+            });
+
+            auto item = pool.TakeShared();
+        }
+
+        REQUIRE(resets.load() == 1);
+    }
+}
@@ -0,0 +1,129 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "../src/Pool.h"
+#include "../src/RingIndexer.h"
+
+using namespace dxpool;
+using namespace std;
+
+TEST_CASE("Ring indexer", "[indexer][ring]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("Indices are taken in the order they were returned") {
+        RingIndexer indexer(4);
+        vector<size_t> batch(4);
+        REQUIRE(indexer.Next(4, batch.data()) == 4);
+        REQUIRE(batch == vector<size_t>{0, 1, 2, 3});
+        REQUIRE(indexer.Next().Empty());
+
+        indexer.Return(2);
+        indexer.Return(0);
+        vector<size_t> returned{3, 1};
+        indexer.Return(returned.data(), returned.size());
+
+        REQUIRE(indexer.Next(4, batch.data()) == 4);
+        REQUIRE(batch == vector<size_t>{2, 0, 3, 1});
+    }
+
+    SECTION("Indices keep their order over many laps of the ring") {
+        constexpr const size_t maxSize = 3;
+        RingIndexer indexer(maxSize);
+        for(size_t lap = 0 ; lap < 1000 ; lap++) {
+            const size_t index = indexer.Next().Get();
+            REQUIRE(index == lap % maxSize);
+            indexer.Return(index);
+        }
+
+        REQUIRE(indexer.Next().Get() == 1000 % maxSize);
+    }
+
+    SECTION("Empty indexer") {
+        RingIndexer indexer(0);
+        vector<size_t> batch(1);
+        REQUIRE(indexer.Next().Empty());
+        REQUIRE(indexer.Next(1, batch.data()) == 0);
+    }
+
+    SECTION("Indices must fit in 32 bits") {
+        REQUIRE_THROWS_AS(RingIndexer(static_cast<IndexSizeT>(0x100000000ULL)), InvalidRingIndexerArgumentsError);
+    }
+
+    SECTION("Statistics") {
+        BasicRingIndexer<ShardedStats> indexer(4);
+        vector<size_t> batch(4);
+        REQUIRE(indexer.Next(4, batch.data()) == 4);
+        REQUIRE(indexer.Next().Empty());
+        indexer.Return(batch.data(), 2);
+        indexer.Return(batch[2]);
+
+        const auto stats = indexer.Stats();
+        REQUIRE(stats.taken == 4);
+        REQUIRE(stats.returned == 3);
+        REQUIRE(stats.takeFailures == 1);
+        REQUIRE(stats.casRetries == 0);
+        REQUIRE(stats.highWatermark == 4);
+    }
+
+    SECTION("Indices are not handed out twice while more threads than indices take and return them") {
+        constexpr const size_t threadCount = 8;
+        constexpr const int iterations = 5000;
+        constexpr const size_t maxSize = 3;
+        RingIndexer indexer(maxSize);
+
+        vector<atomic<int>> owners(maxSize);
+        atomic<bool> shared{false};
+        vector<thread> threads;
+        for(size_t t = 0 ; t < threadCount ; t++) {
+            threads.emplace_back([&indexer, &owners, &shared]() {
+                for(int n = 0 ; n < iterations ; n++) {
+                    auto result = indexer.Next();
+                    if(result.Empty()) {
+                        this_thread::yield();
+                        continue;
+                    }
+
+                    const size_t index = result.Get();
+                    if(owners[index].fetch_add(1) != 0) {
+                        shared = true;
+                    }
+
+                    owners[index].fetch_sub(1);
+                    indexer.Return(index);
+                }
+            });
+        }
+
+        for(auto& thread: threads) {
+            thread.join();
+        }
+
+        REQUIRE_FALSE(shared);
+
+        set<size_t> indices;
+        for(auto result = indexer.Next() ; !result.Empty(); result = indexer.Next()) {
+            indices.insert(result.Get());
+        }
+
+        REQUIRE(indices.size() == maxSize);
+    }
+}
+
+TEST_CASE("Pool with a ring indexer", "[pool][indexer][ring]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("Returned items are taken last") {
+        RuntimePool<int, RingIndexer> pool(2);
+        int* first = nullptr;
+        {
+            auto item = pool.Take();
+            first = item.Get();
+        }
+
+        auto second = pool.Take();
+        REQUIRE(second.Get() != first);
+        auto third = pool.Take();
+        REQUIRE(third.Get() == first);
+    }
+}
@@ -0,0 +1,116 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "../src/ConcurrentIndexer.h"
+#include "../src/MutexIndexer.h"
+#include "../src/Pool.h"
+#include "../src/RseqIndexer.h"
+
+using namespace dxpool;
+using namespace std;
+
+TEST_CASE("Rseq indexer", "[indexer][rseq]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("Indices are cached per CPU only when rseq is available") {
+        RseqIndexer<> indexer(8);
+#ifdef DXPOOL_HAS_RSEQ
+        REQUIRE(indexer.PerCpu() == (__rseq_size > 0));
+#else
+        REQUIRE_FALSE(indexer.PerCpu());
+#endif
+    }
+
+    SECTION("Indices cached by CPUs are taken once the shared indexer runs out") {
+        constexpr const size_t maxSize = 16;
+        RseqIndexer<MutexIndexer, 8> indexer(maxSize);
+
+        vector<size_t> taken(maxSize);
+        REQUIRE(indexer.Next(maxSize, taken.data()) == maxSize);
+        REQUIRE(indexer.Next().Empty());
+
+        // up to 8 indices are kept in the cache of the current CPU and the rest go to the shared indexer
+        indexer.Return(taken.data(), maxSize);
+
+        set<size_t> indices;
+        for(auto result = indexer.Next() ; !result.Empty(); result = indexer.Next()) {
+            indices.insert(result.Get());
+        }
+
+        REQUIRE(indices.size() == maxSize);
+    }
+
+    SECTION("Flushed indices are available") {
+        constexpr const size_t maxSize = 4;
+        RseqIndexer<ConcurrentIndexer, 4> indexer(maxSize);
+
+        vector<size_t> taken(maxSize);
+        REQUIRE(indexer.Next(maxSize, taken.data()) == maxSize);
+        for(const auto index: taken) {
+            indexer.Return(index);
+        }
+
+        indexer.Flush();
+        REQUIRE(indexer.Next(maxSize, taken.data()) == maxSize);
+        REQUIRE(set<size_t>(taken.begin(), taken.end()).size() == maxSize);
+    }
+
+    SECTION("Indices are not handed out twice while threads on all CPUs take and return them") {
+        constexpr const size_t threadCount = 16;
+        constexpr const int iterations = 5000;
+        constexpr const size_t maxSize = 24;
+        RseqIndexer<ConcurrentIndexer, 4> indexer(maxSize);
+
+        vector<atomic<int>> owners(maxSize);
+        atomic<bool> shared{false};
+        vector<thread> threads;
+        for(size_t t = 0 ; t < threadCount ; t++) {
+            threads.emplace_back([&indexer, &owners, &shared]() {
+                for(int n = 0 ; n < iterations ; n++) {
+                    auto result = indexer.Next();
+                    if(result.Empty()) {
+                        this_thread::yield();
+                        continue;
+                    }
+
+                    const size_t index = result.Get();
+                    if(owners[index].fetch_add(1) != 0) {
+                        shared = true;
+                    }
+
+                    owners[index].fetch_sub(1);
+                    indexer.Return(index);
+                }
+            });
+        }
+
+        for(auto& thread: threads) {
+            thread.join();
+        }
+
+        REQUIRE_FALSE(shared);
+
+        set<size_t> indices;
+        for(auto result = indexer.Next() ; !result.Empty(); result = indexer.Next()) {
+            indices.insert(result.Get());
+        }
+
+        REQUIRE(indices.size() == maxSize);
+    }
+}
+
+TEST_CASE("Pool with a rseq indexer", "[pool][indexer][rseq]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("All items can be taken in a batch after being returned one by one") {
+        using RseqPool = RuntimePool<int, RseqIndexer<>>;
+        RseqPool pool(128);
+        vector<RseqPool::Handle> handles;
+        REQUIRE(pool.TakeBatch(128, handles) == 128);
+
+        handles.clear();
+        REQUIRE(pool.TakeBatch(128, handles) == 128);
+        REQUIRE(pool.TakeHandle().Empty());
+    }
+}
@@ -0,0 +1,144 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "../src/SegmentedPool.h"
+#include "../src/ConcurrentIndexer.h"
+#include "../src/MutexIndexer.h"
+#include "TestTypes.h"
+
+using namespace dxpool;
+using namespace std;
+
+TEST_CASE("Segmented pool", "[segmentedpool]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+    constexpr const IndexSizeT segmentSize = 4;
+    constexpr const IndexSizeT maxSegments = 3;
+
+    SECTION("Invalid arguments") {
+        using PoolType = SegmentedPool<int>;
+        REQUIRE_THROWS_AS(PoolType(0, maxSegments), InvalidSegmentedPoolArgumentsError);
+        REQUIRE_THROWS_AS(PoolType(segmentSize, 0), InvalidSegmentedPoolArgumentsError);
+    }
+
+    SECTION("Grows one segment at a time up to its capacity") {
+        SegmentedPool<ResetableNoCopyMoveObject, ConcurrentIndexer> pool(segmentSize, maxSegments);
+        REQUIRE(pool.Size() == segmentSize);
+        REQUIRE(pool.Capacity() == segmentSize * maxSegments);
+
+        vector<decltype(pool)::Handle> handles;
+        set<IndexSizeT> indices;
+
+        for(IndexSizeT i = 0 ; i < pool.Capacity() ; i++) {
+            auto handle = pool.TakeHandle();
+            REQUIRE_FALSE(handle.Empty());
+            REQUIRE(handle.Get()->Value() == ResetableCopyMoveObject<>::DefaultNonCopiableObjectValue);
+            REQUIRE(pool.Size() == (i / segmentSize + 1) * segmentSize);
+
+            indices.insert(handle.PoolIndex());
+            handles.push_back(std::move(handle));
+        }
+
+        REQUIRE(indices.size() == pool.Capacity());
+        REQUIRE(pool.TakeHandle().Empty());
+        REQUIRE(pool.Take().Empty());
+    }
+
+    SECTION("Items never move when the pool grows") {
+        SegmentedPool<ResetableNoCopyMoveObject> pool(segmentSize, maxSegments);
+
+        vector<decltype(pool)::Handle> handles;
+        vector<ResetableNoCopyMoveObject*> addresses;
+
+        for(IndexSizeT i = 0 ; i < pool.Capacity() ; i++) {
+            handles.push_back(pool.TakeHandle());
+            addresses.push_back(handles.back().Get());
+        }
+
+        for(size_t i = 0 ; i < handles.size() ; i++) {
+            REQUIRE(handles[i].Get() == addresses[i]);
+        }
+
+        // returned items are reused, not reallocated
+        handles.clear();
+        for(IndexSizeT i = 0 ; i < pool.Capacity() ; i++) {
+            auto item = pool.Take();
+            REQUIRE(find(addresses.begin(), addresses.end(), item.Get()) != addresses.end());
+            REQUIRE(item.Get()->WasReset());
+        }
+        REQUIRE(pool.Size() == pool.Capacity());
+    }
+
+    SECTION("Invoke custom reseter") {
+        const int resetValue = 64;
+        SegmentedPool<int> pool(1, 2, [](int* item) {
+            *item = resetValue;
+        });
+
+        int* value = nullptr;
+        {
+            auto item = pool.Take();
+            value = item.Get();
+        }
+
+        REQUIRE(*value == resetValue);
+        REQUIRE(pool.Size() == 1);
+    }
+
+    SECTION("Reset policy given at compile time") {
+        SegmentedPool<ResetableNoCopyMoveObject, MutexIndexer, NoReset> pool(1, 1);
+        ResetableNoCopyMoveObject* value = nullptr;
+        {
+            auto item = pool.Take();
+            value = item.Get();
+        }
+
+        REQUIRE_FALSE(value->WasReset());
+    }
+
+    SECTION("Take and return from multiple threads while growing") {
+        const int threadCount = 8;
+        const int iterations = 300;
+        const IndexSizeT itemsPerThread = 3;
+        SegmentedPool<int, ConcurrentIndexer> pool(2, threadCount * itemsPerThread);
+
+        atomic<bool> failed{false};
+        list<thread> threads;
+
+        for(int i = 0 ; i < threadCount ; i++) {
+            threads.emplace_back([&pool, &failed]() {
+                for(int iteration = 0 ; iteration < iterations ; iteration++) {
+                    vector<decltype(pool)::Handle> handles;
+                    for(IndexSizeT item = 0 ; item < itemsPerThread ; item++) {
+                        auto handle = pool.TakeHandle();
+                        if(handle.Empty()) {
+                            failed = true;
+                            return;
+                        }
+                        // each item must be held by a single thread
+                        *handle.Get() += 1;
+                        if(*handle.Get() != 1) {
+                            failed = true;
+                        }
+                        handles.push_back(std::move(handle));
+                    }
+
+                    this_thread::yield();
+                    for(auto& handle: handles) {
+                        *handle.Get() -= 1;
+                    }
+                }
+            });
+        }
+
+        for(auto& poolThread: threads) {
+            poolThread.join();
+        }
+
+        REQUIRE_FALSE(failed);
+        REQUIRE(pool.Size() <= pool.Capacity());
+    }
+}
@@ -0,0 +1,144 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../src/SharedPoolItem.h"
+#include "../src/MutexIndexer.h"
+#include "../src/ConcurrentIndexer.h"
+#include "../src/Pool.h"
+#include "TestTypes.h"
+
+using namespace dxpool;
+using namespace std;
+
+TEST_CASE("Shared pool item", "[sharedpoolitem]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("Empty shared item by default") {
+        SharedPoolItem<StaticPool<int, 1>> sharedItem;
+        REQUIRE(sharedItem.Empty());
+        REQUIRE(sharedItem.UseCount() == 0);
+    }
+
+    SECTION("Copies share the item") {
+        StaticPool<ResetableNoCopyMoveObject, 1> pool;
+        auto original = pool.TakeShared();
+        REQUIRE_FALSE(original.Empty());
+        REQUIRE(original.UseCount() == 1);
+
+        auto copy = original; // NOLINT(performance-unnecessary-copy-initialization)
+        REQUIRE(copy.Get() == original.Get());
+        REQUIRE(copy.PoolIndex() == original.PoolIndex());
+        REQUIRE(original.UseCount() == 2);
+
+        {
+            const auto innerCopy(copy);
+            REQUIRE(original.UseCount() == 3);
+        }
+
+        REQUIRE(original.UseCount() == 2);
+        REQUIRE(pool.TakeShared().Empty());
+    }
+
+    SECTION("Last release resets and returns the item") {
+        StaticPool<ResetableNoCopyMoveObject, 1> pool;
+        ResetableNoCopyMoveObject* obj = nullptr;
+        {
+            auto original = pool.TakeShared();
+            obj = original.Get();
+            vector<StaticPool<ResetableNoCopyMoveObject, 1>::SharedItem> copies(3, original);
+
+            original = {};
+            REQUIRE_FALSE(obj->WasReset());
+            REQUIRE(pool.TakeShared().Empty());
+
+            copies.resize(1);
+            REQUIRE_FALSE(obj->WasReset());
+            REQUIRE(copies.front().UseCount() == 1);
+        }
+
+        REQUIRE(obj->WasReset());
+        REQUIRE(obj->Value() == 0);
+        REQUIRE_FALSE(pool.TakeShared().Empty());
+    }
+
+    SECTION("Invoke custom reseter") {
+        const int resetValue = 11;
+        RuntimePool<int> pool(1, [](int* item) {
+            *item = resetValue;
+        });
+
+        int* value = nullptr;
+        {
+            auto original = pool.TakeShared();
+            value = original.Get();
+            *value = resetValue + 1;
+            const auto copy = original;
+        }
+
+        REQUIRE(*value == resetValue);
+    }
+
+    SECTION("Move and assignment") {
+        StaticPool<ResetableNoCopyMoveObject, 2> pool;
+        auto first = pool.TakeShared();
+        auto second = pool.TakeShared();
+        REQUIRE(pool.TakeShared().Empty());
+
+        auto moved(std::move(first));
+        REQUIRE(first.Empty()); // NOLINT(bugprone-use-after-move,clang-analyzer-cplusplus.Move)
+        REQUIRE(moved.UseCount() == 1);
+
+        // assigning over the only reference of an item returns it to the pool
+        moved = second;
+        REQUIRE(moved.UseCount() == 2);
+        REQUIRE(moved.Get() == second.Get());
+
+        auto retaken = pool.TakeShared();
+        REQUIRE_FALSE(retaken.Empty());
+
+        moved = moved; // NOLINT(clang-diagnostic-self-assign-overloaded)
+        REQUIRE(moved.UseCount() == 2);
+    }
+
+    SECTION("Fan out an item to several threads") {
+        constexpr const IndexSizeT poolSize = 4;
+        constexpr const size_t consumerCount = 8;
+        constexpr const int messages = 200;
+        RuntimePool<int, ConcurrentIndexer> pool(poolSize, [](int* item) {
+            *item = -1;
+        });
+        atomic<int> consumed{0};
+
+        for(int message = 0 ; message < messages ; message++) {
+            auto sharedItem = pool.TakeShared();
+            REQUIRE_FALSE(sharedItem.Empty());
+            *sharedItem.Get() = message;
+
+            vector<thread> consumers;
+            for(size_t i = 0 ; i < consumerCount ; i++) {
+                consumers.emplace_back([sharedItem, message, &consumed]() {
+                    if(*sharedItem.Get() == message) {
+                        consumed.fetch_add(1, memory_order_relaxed);
+                    }
+                });
+            }
+
+            sharedItem = {};
+            for(auto& consumer: consumers) {
+                consumer.join();
+            }
+        }
+
+        REQUIRE(consumed.load() == messages * static_cast<int>(consumerCount));
+
+        vector<RuntimePool<int, ConcurrentIndexer>::SharedItem> sharedItems;
+        for(IndexSizeT i = 0 ; i < poolSize ; i++) {
+            sharedItems.push_back(pool.TakeShared());
+            REQUIRE_FALSE(sharedItems.back().Empty());
+            REQUIRE(*sharedItems.back().Get() == -1);
+        }
+    }
+}
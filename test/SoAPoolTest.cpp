@@ -0,0 +1,140 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/ConcurrentIndexer.h"
+#include "../src/MutexIndexer.h"
+#include "../src/SoAPool.h"
+
+using namespace dxpool;
+using namespace std;
+
+namespace {
+
+enum SessionField : std::size_t {
+    Id,
+    Deadline,
+    Name
+};
+
+using SessionPool = SoAPool<SoAFields<std::uint32_t, std::int64_t, std::string>, ConcurrentIndexer>;
+
+struct SessionReset {
+    inline auto operator()(std::uint32_t* id, std::int64_t* deadline, std::string* name) const -> void {
+        *id = 0;
+        *deadline = -1;
+        name->clear();
+    }
+};
+
+} // namespace
+
+TEST_CASE("Struct of arrays pool", "[soapool]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("Fields are value initialized and stored in separate arrays") {
+        SessionPool pool(4);
+        REQUIRE(pool.Size() == 4);
+
+        for(IndexSizeT i = 0 ; i < pool.Size() ; i++) {
+            REQUIRE(pool.FieldData<Id>()[i] == 0);
+            REQUIRE(pool.FieldData<Deadline>()[i] == 0);
+            REQUIRE(pool.FieldData<Name>()[i].empty());
+        }
+
+        auto item = pool.Take();
+        REQUIRE_FALSE(item.Empty());
+        REQUIRE(&item.Field<Deadline>() == &pool.FieldData<Deadline>()[item.PoolIndex()]);
+        REQUIRE(&item.Field<Id>() == &pool.FieldData<Id>()[item.PoolIndex()]);
+    }
+
+    SECTION("Fields written through handles are visible in the field arrays") {
+        SessionPool pool(8);
+        vector<SessionPool::Handle> handles;
+        for(std::uint32_t i = 0 ; i < 8 ; i++) {
+            handles.push_back(pool.Take());
+            handles.back().Field<Id>() = i;
+            handles.back().Field<Deadline>() = i * 10;
+            handles.back().Field<Name>() = "session";
+        }
+
+        REQUIRE(pool.Take().Empty());
+
+        std::int64_t deadlines = 0;
+        const auto* deadline = pool.FieldData<Deadline>();
+        for(IndexSizeT i = 0 ; i < pool.Size() ; i++) {
+            deadlines += deadline[i];
+        }
+
+        REQUIRE(deadlines == 280);
+    }
+
+    SECTION("Items are returned when the handle is destroyed") {
+        SoAPool<SoAFields<int, double>> pool(1);
+        {
+            auto item = pool.Take();
+            item.Field<0>() = 3;
+            REQUIRE(pool.Take().Empty());
+        }
+
+        auto item = pool.Take();
+        REQUIRE_FALSE(item.Empty());
+        // returned as is without a reset policy
+        REQUIRE(item.Field<0>() == 3);
+    }
+
+    SECTION("Reset policy gets every field of the item") {
+        SoAPool<SoAFields<std::uint32_t, std::int64_t, std::string>, ConcurrentIndexer, SessionReset> pool(1);
+
+        {
+            auto item = pool.Take();
+            item.Field<Id>() = 1;
+            item.Field<Deadline>() = 2;
+            item.Field<Name>() = "name";
+        }
+
+        REQUIRE(pool.FieldData<Id>()[0] == 0);
+        REQUIRE(pool.FieldData<Deadline>()[0] == -1);
+        REQUIRE(pool.FieldData<Name>()[0].empty());
+    }
+
+    SECTION("Moved handles are empty") {
+        SoAPool<SoAFields<int>, MutexIndexer> pool(1);
+        auto item = pool.Take();
+        auto moved = std::move(item);
+
+        REQUIRE(item.Empty()); // NOLINT(bugprone-use-after-move, hicpp-invalid-access-moved)
+        REQUIRE_FALSE(moved.Empty());
+    }
+
+    SECTION("Taking and returning from many threads") {
+        constexpr const size_t threadCount = 8;
+        constexpr const int iterations = 1000;
+        SoAPool<SoAFields<int, std::int64_t>, MutexIndexer> pool(4);
+
+        atomic<int> sharedItems{0};
+        vector<thread> threads;
+        for(size_t t = 0 ; t < threadCount ; t++) {
+            threads.emplace_back([&pool, &sharedItems]() {
+                for(int n = 0 ; n < iterations ; n++) {
+                    auto item = pool.Take();
+                    if(!item.Empty()) {
+                        item.Field<0>()++;
+                        if(item.Field<0>() != 1) {
+                            sharedItems++;
+                        }
+                        item.Field<0>()--;
+                    }
+                }
+            });
+        }
+
+        for(auto& thread: threads) {
+            thread.join();
+        }
+
+        REQUIRE(sharedItems.load() == 0);
+    }
+}
@@ -0,0 +1,122 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "../src/Pool.h"
+#include "../src/StackIndexer.h"
+
+using namespace dxpool;
+using namespace std;
+
+TEST_CASE("Stack indexer", "[indexer][stack]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("The most recently returned index is taken first") {
+        StackIndexer indexer(8);
+        const size_t first = indexer.Next().Get();
+        const size_t second = indexer.Next().Get();
+        REQUIRE(first == 0);
+        REQUIRE(second == 1);
+
+        indexer.Return(first);
+        indexer.Return(second);
+        REQUIRE(indexer.Next().Get() == second);
+        REQUIRE(indexer.Next().Get() == first);
+    }
+
+    SECTION("The first index of a returned batch is on top") {
+        StackIndexer indexer(8);
+        vector<size_t> batch(3);
+        REQUIRE(indexer.Next(3, batch.data()) == 3);
+        REQUIRE(batch == vector<size_t>{0, 1, 2});
+
+        indexer.Return(batch.data(), 3);
+        REQUIRE(indexer.Next().Get() == 0);
+        REQUIRE(indexer.Next().Get() == 1);
+        REQUIRE(indexer.Next().Get() == 2);
+        REQUIRE(indexer.Next().Get() == 3);
+    }
+
+    SECTION("Empty indexer") {
+        StackIndexer indexer(0);
+        vector<size_t> batch(1);
+        REQUIRE(indexer.Next().Empty());
+        REQUIRE(indexer.Next(1, batch.data()) == 0);
+    }
+
+    SECTION("Indices must fit in 32 bits") {
+        REQUIRE_THROWS_AS(StackIndexer(static_cast<IndexSizeT>(0xFFFFFFFFULL)), InvalidStackIndexerArgumentsError);
+    }
+
+    SECTION("Statistics") {
+        BasicStackIndexer<ShardedStats> indexer(4);
+        vector<size_t> batch(4);
+        REQUIRE(indexer.Next(4, batch.data()) == 4);
+        indexer.Return(batch.data(), 2);
+        indexer.Return(batch[2]);
+
+        const auto stats = indexer.Stats();
+        REQUIRE(stats.taken == 4);
+        REQUIRE(stats.returned == 3);
+        REQUIRE(stats.highWatermark == 4);
+    }
+
+    SECTION("Indices are not handed out twice while threads take and return the same few indices") {
+        constexpr const size_t threadCount = 8;
+        constexpr const int iterations = 5000;
+        constexpr const size_t maxSize = 4;
+        StackIndexer indexer(maxSize);
+
+        vector<atomic<int>> owners(maxSize);
+        atomic<bool> shared{false};
+        vector<thread> threads;
+        for(size_t t = 0 ; t < threadCount ; t++) {
+            threads.emplace_back([&indexer, &owners, &shared]() {
+                for(int n = 0 ; n < iterations ; n++) {
+                    auto result = indexer.Next();
+                    if(result.Empty()) {
+                        this_thread::yield();
+                        continue;
+                    }
+
+                    const size_t index = result.Get();
+                    if(owners[index].fetch_add(1) != 0) {
+                        shared = true;
+                    }
+
+                    owners[index].fetch_sub(1);
+                    indexer.Return(index);
+                }
+            });
+        }
+
+        for(auto& thread: threads) {
+            thread.join();
+        }
+
+        REQUIRE_FALSE(shared);
+
+        set<size_t> indices;
+        for(auto result = indexer.Next() ; !result.Empty(); result = indexer.Next()) {
+            indices.insert(result.Get());
+        }
+
+        REQUIRE(indices.size() == maxSize);
+    }
+}
+
+TEST_CASE("Pool with a stack indexer", "[pool][indexer][stack]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+
+    SECTION("A returned item is the next one taken") {
+        RuntimePool<int, StackIndexer> pool(16);
+        int* first = nullptr;
+        {
+            auto item = pool.Take();
+            first = item.Get();
+        }
+
+        auto item = pool.Take();
+        REQUIRE(item.Get() == first);
+    }
+}
@@ -0,0 +1,105 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <thread>
+#include <vector>
+
+#include "../src/ConcurrentIndexer.h"
+#include "../src/MutexIndexer.h"
+#include "../src/Pool.h"
+#include "../src/WaitableIndexer.h"
+
+using namespace dxpool;
+using namespace std;
+
+template<typename Indexer>
+auto verifyWaitingTakes() -> void {
+    constexpr const IndexSizeT poolSize = 2;
+    RuntimePool<int, WaitableIndexer<Indexer>> pool(poolSize);
+
+    SECTION("Timed take gives up when the pool stays empty") {
+        auto first = pool.Take();
+        auto second = pool.Take();
+        REQUIRE(pool.Take().Empty());
+
+        const auto start = chrono::steady_clock::now();
+        auto item = pool.TakeFor(chrono::milliseconds(20));
+        REQUIRE(item.Empty());
+        REQUIRE(chrono::steady_clock::now() - start >= chrono::milliseconds(20));
+    }
+
+    SECTION("Waiting take wakes up when an item is returned") {
+        vector<PoolItem<int>> items;
+        items.push_back(pool.Take());
+        items.push_back(pool.Take());
+
+        atomic<bool> taken{false};
+        thread waiter([&pool, &taken]() {
+            auto item = pool.TakeWait();
+            taken = !item.Empty();
+        });
+
+        this_thread::sleep_for(chrono::milliseconds(10));
+        REQUIRE_FALSE(taken);
+
+        items.pop_back();
+        waiter.join();
+        REQUIRE(taken);
+    }
+
+    SECTION("Timed take succeeds when an item is returned in time") {
+        vector<PoolItem<int>> items;
+        items.push_back(pool.Take());
+        items.push_back(pool.Take());
+
+        bool taken = false;
+        thread waiter([&pool, &taken]() {
+            taken = !pool.TakeFor(chrono::seconds(10)).Empty();
+        });
+
+        this_thread::sleep_for(chrono::milliseconds(10));
+        items.pop_back();
+        waiter.join();
+        REQUIRE(taken);
+    }
+
+    SECTION("Many threads waiting on few items") {
+        const int threadCount = 8;
+        const int iterations = 200;
+        atomic<int> completed{0};
+        atomic<bool> failed{false};
+        list<thread> threads;
+
+        for(int i = 0 ; i < threadCount ; i++) {
+            threads.emplace_back([&pool, &completed, &failed]() {
+                for(int iteration = 0 ; iteration < iterations ; iteration++) {
+                    auto item = pool.TakeWait();
+                    *item.Get() += 1;
+                    if(*item.Get() != 1) {
+                        failed = true;
+                    }
+                    *item.Get() -= 1;
+                    completed++;
+                }
+            });
+        }
+
+        for(auto& poolThread: threads) {
+            poolThread.join();
+        }
+
+        REQUIRE_FALSE(failed);
+        REQUIRE(completed == threadCount * iterations);
+    }
+}
+
+TEST_CASE("Waitable indexer", "[indexer][waitable]") { // NOLINT(cppcoreguidelines-avoid-non-const-global-variables, readability-function-cognitive-complexity)
+    SECTION("Mutex indexer") {
+        verifyWaitingTakes<MutexIndexer>();
+    }
+
+    SECTION("Concurrent indexer") {
+        verifyWaitingTakes<ConcurrentIndexer>();
+    }
+}